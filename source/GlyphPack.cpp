@@ -0,0 +1,285 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/GlyphPack.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+
+#if WATCH_FACE_GRAYSCALE
+#include "uif-ui-watch-face-wrd/GrayFrameBuffer.h"
+#endif
+
+#include <cstring>
+
+/*  Receives ink runs from glyphPackForEachRun.
+*/
+class FrameBufferSink
+{
+public:
+    FrameBufferSink(SharedPointer<FrameBuffer>& _canvas, uint8_t _color,
+                    int32_t _x = 0, int32_t _y = 0)
+        :   canvas(_canvas),
+            color(_color),
+            x(_x),
+            y(_y)
+    {
+    }
+
+    void ink(int32_t x0, int32_t x1, int32_t _y)
+    {
+        canvas->drawRectangle(x + x0, x + x1, y + _y, y + _y + 1, color);
+    }
+
+private:
+    SharedPointer<FrameBuffer>& canvas;
+    uint8_t color;
+    int32_t x;
+    int32_t y;
+};
+
+#if WATCH_FACE_GRAYSCALE
+/*  Receives rows of coverage from glyphPackForEachSpan.
+*/
+class GrayFrameBufferSink
+{
+public:
+    GrayFrameBufferSink(GrayFrameBuffer* _canvas, uint8_t _level,
+                        int32_t _x = 0, int32_t _y = 0)
+        :   canvas(_canvas),
+            level(_level),
+            x(_x),
+            y(_y)
+    {
+    }
+
+    void coverage(int32_t _x, int32_t _y, const uint8_t* values, int32_t count)
+    {
+        canvas->blendSpan(x + _x, y + _y, values, count, level);
+    }
+
+private:
+    GrayFrameBuffer* canvas;
+    uint8_t level;
+    int32_t x;
+    int32_t y;
+};
+#endif
+
+const glyph_pack_entry_t* glyphPackFind(const glyph_pack_t* pack, const char* label)
+{
+    /*  The generator sorts the index by label, so a binary search is enough.
+    */
+    int32_t low = 0;
+    int32_t high = (int32_t) pack->entries - 1;
+
+    while (low <= high)
+    {
+        int32_t middle = (low + high) / 2;
+        int result = strcmp(label, pack->index[middle].label);
+
+        if (result == 0)
+        {
+            return &pack->index[middle];
+        }
+        else if (result < 0)
+        {
+            high = middle - 1;
+        }
+        else
+        {
+            low = middle + 1;
+        }
+    }
+
+    return NULL;
+}
+
+void glyphPackDraw(const glyph_pack_t* pack,
+                   const glyph_pack_entry_t* entry,
+                   SharedPointer<FrameBuffer>& canvas,
+                   int16_t xOffset,
+                   int16_t yOffset,
+                   bool inverse,
+                   GrayFrameBuffer* gray)
+{
+    /*  Canvas pixel (x, y) shows bitmap pixel (x - xOffset, y - yOffset).
+        Negative offsets mean the top/left part of the bitmap is outside the
+        canvas.
+    */
+    int32_t columns = (int32_t) entry->width + xOffset;
+    int32_t rows = (int32_t) entry->height + yOffset;
+
+    if (columns > canvas->getWidth())
+    {
+        columns = canvas->getWidth();
+    }
+
+    if (rows > canvas->getHeight())
+    {
+        rows = canvas->getHeight();
+    }
+
+    if ((columns <= 0) || (rows <= 0))
+    {
+        return;
+    }
+
+    uint8_t ink = (inverse) ? 1 : 0;
+    uint8_t background = (inverse) ? 0 : 1;
+
+    /* background for the whole visible area in one go */
+    canvas->drawRectangle(0, columns, 0, rows, background);
+
+#if WATCH_FACE_GRAYSCALE
+    /*  Anti-aliased entries are blended into packed gray canvases. On
+        other canvases, or with grayscale compiled out, they fall through
+        and are thresholded.
+    */
+    if (glyphFormatGrayBits(entry->format) && gray)
+    {
+        GrayFrameBufferSink sink(gray, (inverse) ? 255 : 0);
+
+        glyphPackForEachSpan(pack, entry, xOffset, yOffset, columns, rows, sink);
+
+        return;
+    }
+#else
+    (void) gray;
+#endif
+
+    /*  Only ink is drawn, one drawRectangle call per horizontal run and
+        row, regardless of the glyph's format.
+    */
+    FrameBufferSink sink(canvas, ink);
+
+    glyphPackForEachRun(pack, entry, xOffset, yOffset, columns, rows, sink);
+}
+
+void glyphPackDrawInk(const glyph_pack_t* pack,
+                      const glyph_pack_entry_t* entry,
+                      SharedPointer<FrameBuffer>& canvas,
+                      int32_t x,
+                      int32_t y,
+                      bool inverse,
+                      GrayFrameBuffer* gray)
+{
+    /*  The decoders only clip at the top and left, so the part of the
+        canvas right of and below (x, y) is handed to them as their
+        destination and the sinks move the runs back into place.
+    */
+    int32_t left = (x > 0) ? x : 0;
+    int32_t top = (y > 0) ? y : 0;
+    int32_t xOffset = x - left;
+    int32_t yOffset = y - top;
+
+    int32_t columns = (int32_t) entry->width + xOffset;
+    int32_t rows = (int32_t) entry->height + yOffset;
+
+    if (columns > canvas->getWidth() - left)
+    {
+        columns = canvas->getWidth() - left;
+    }
+
+    if (rows > canvas->getHeight() - top)
+    {
+        rows = canvas->getHeight() - top;
+    }
+
+    if ((columns <= 0) || (rows <= 0))
+    {
+        return;
+    }
+
+#if WATCH_FACE_GRAYSCALE
+    if (glyphFormatGrayBits(entry->format) && gray)
+    {
+        GrayFrameBufferSink sink(gray, (inverse) ? 255 : 0, left, top);
+
+        glyphPackForEachSpan(pack, entry, xOffset, yOffset, columns, rows, sink);
+
+        return;
+    }
+#else
+    (void) gray;
+#endif
+
+    FrameBufferSink sink(canvas, (inverse) ? 1 : 0, left, top);
+
+    glyphPackForEachRun(pack, entry, xOffset, yOffset, columns, rows, sink);
+}
+
+/*****************************************************************************/
+/* View                                                                      */
+/*****************************************************************************/
+
+GlyphPackView::GlyphPackView(const glyph_pack_t* _pack, const char* label)
+    :   UIView(),
+        pack(_pack),
+        entry(NULL),
+        inverse(false),
+        grayCanvas(NULL)
+{
+    setLabel(label);
+}
+
+void GlyphPackView::setLabel(const char* label)
+{
+    entry = glyphPackFind(pack, label);
+
+    if (entry)
+    {
+        UIView::width = entry->width;
+        UIView::height = entry->height;
+    }
+    else
+    {
+        UIView::width = 0;
+        UIView::height = 0;
+    }
+}
+
+uint32_t GlyphPackView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
+                                        int16_t xOffset,
+                                        int16_t yOffset)
+{
+    if (entry)
+    {
+        GrayFrameBuffer* gray = NULL;
+
+#if WATCH_FACE_GRAYSCALE
+        /* the owner vouches for the canvas, see setGrayCanvas */
+        if (grayCanvas && *grayCanvas)
+        {
+            gray = static_cast<GrayFrameBuffer*>(canvas.get());
+        }
+#endif
+
+        glyphPackDraw(pack, entry, canvas, xOffset, yOffset, inverse, gray);
+    }
+
+    return 0xFFFFFFFF;
+}
+
+void GlyphPackView::setInverse(bool _inverse)
+{
+    inverse = _inverse;
+}
+
+void GlyphPackView::setGrayCanvas(const bool* gray)
+{
+    grayCanvas = gray;
+}
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/GrayFrameBuffer.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+
+#if WATCH_FACE_GRAYSCALE
+
+#include "uif-ui-watch-face-wrd/GlyphBlend.h"
+
+#include <cstring>
+
+GrayFrameBuffer::GrayFrameBuffer(uint8_t* _buffer, uint8_t _bitsPerPixel, uint16_t _width, uint16_t _height)
+    :   ScrollFrameBuffer(),
+        buffer(_buffer),
+        bitsPerPixel(_bitsPerPixel),
+        stride(((_width * _bitsPerPixel) + 7) / 8),
+        xOrigin(0),
+        yOrigin(0),
+        width(_width),
+        height(_height)
+{
+}
+
+GrayFrameBuffer::GrayFrameBuffer(uint8_t* _buffer, uint8_t _bitsPerPixel, uint16_t _stride,
+                                 uint16_t _xOrigin, uint16_t _yOrigin, uint16_t _width, uint16_t _height)
+    :   ScrollFrameBuffer(),
+        buffer(_buffer),
+        bitsPerPixel(_bitsPerPixel),
+        stride(_stride),
+        xOrigin(_xOrigin),
+        yOrigin(_yOrigin),
+        width(_width),
+        height(_height)
+{
+}
+
+uint8_t GrayFrameBuffer::readLevel(uint32_t x, uint32_t y) const
+{
+    uint32_t bit = (xOrigin + x) * bitsPerPixel;
+    uint32_t shift = 8 - bitsPerPixel - (bit % 8);
+
+    return (buffer[((yOrigin + y) * stride) + (bit / 8)] >> shift) & ((1 << bitsPerPixel) - 1);
+}
+
+void GrayFrameBuffer::writeLevel(uint32_t x, uint32_t y, uint8_t level)
+{
+    uint32_t bit = (xOrigin + x) * bitsPerPixel;
+    uint32_t shift = 8 - bitsPerPixel - (bit % 8);
+    uint8_t mask = ((1 << bitsPerPixel) - 1) << shift;
+    uint8_t* byte = &buffer[((yOrigin + y) * stride) + (bit / 8)];
+
+    *byte = (*byte & ~mask) | ((level << shift) & mask);
+}
+
+void GrayFrameBuffer::drawPixel(uint16_t x, uint16_t y, uint8_t color)
+{
+    if ((x < width) && (y < height))
+    {
+        writeLevel(x, y, (color) ? (1 << bitsPerPixel) - 1 : 0);
+    }
+}
+
+uint8_t GrayFrameBuffer::getPixel(uint16_t x, uint16_t y) const
+{
+    return ((x < width) && (y < height)) ? readLevel(x, y) : 0;
+}
+
+void GrayFrameBuffer::drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color)
+{
+    x1 = (x1 > width) ? width : x1;
+    y1 = (y1 > height) ? height : y1;
+
+    uint8_t level = (color) ? (1 << bitsPerPixel) - 1 : 0;
+
+    /* whole bytes where the row covers them, single pixels at the ends */
+    uint8_t pixelsPerByte = 8 / bitsPerPixel;
+    uint8_t fill = (level) ? 0xFF : 0x00;
+
+    for (uint32_t y = y0; y < y1; y++)
+    {
+        uint32_t x = x0;
+
+        while ((x < x1) && (((xOrigin + x) % pixelsPerByte) != 0))
+        {
+            writeLevel(x, y, level);
+            x++;
+        }
+
+        uint8_t* row = &buffer[(yOrigin + y) * stride];
+
+        while (x + pixelsPerByte <= x1)
+        {
+            row[((xOrigin + x) * bitsPerPixel) / 8] = fill;
+            x += pixelsPerByte;
+        }
+
+        while (x < x1)
+        {
+            writeLevel(x, y, level);
+            x++;
+        }
+    }
+}
+
+uint16_t GrayFrameBuffer::getWidth() const
+{
+    return width;
+}
+
+uint16_t GrayFrameBuffer::getHeight() const
+{
+    return height;
+}
+
+SharedPointer<FrameBuffer> GrayFrameBuffer::getFrameBuffer(int16_t x, int16_t y, uint16_t _width, uint16_t _height)
+{
+    /* clip the window to this frame buffer */
+    int32_t x0 = (x < 0) ? 0 : x;
+    int32_t y0 = (y < 0) ? 0 : y;
+    int32_t x1 = (int32_t) x + _width;
+    int32_t y1 = (int32_t) y + _height;
+
+    x1 = (x1 > width) ? width : x1;
+    y1 = (y1 > height) ? height : y1;
+    x1 = (x1 < x0) ? x0 : x1;
+    y1 = (y1 < y0) ? y0 : y1;
+
+    return SharedPointer<FrameBuffer>(new GrayFrameBuffer(buffer, bitsPerPixel, stride,
+                                                          xOrigin + x0, yOrigin + y0,
+                                                          x1 - x0, y1 - y0));
+}
+
+void GrayFrameBuffer::scrollUp(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint16_t rows)
+{
+    x1 = (x1 > width) ? width : x1;
+    y1 = (y1 > height) ? height : y1;
+
+    if ((x0 >= x1) || (y0 + rows >= y1))
+    {
+        return;
+    }
+
+    /* split the columns into a ragged head, whole bytes and a ragged tail */
+    uint8_t pixelsPerByte = 8 / bitsPerPixel;
+    uint32_t head = x0;
+    uint32_t tail = x1;
+
+    while ((head < tail) && (((xOrigin + head) % pixelsPerByte) != 0))
+    {
+        head++;
+    }
+
+    while ((tail > head) && (((xOrigin + tail) % pixelsPerByte) != 0))
+    {
+        tail--;
+    }
+
+    uint32_t byte = ((xOrigin + head) * bitsPerPixel) / 8;
+    uint32_t bytes = ((tail - head) * bitsPerPixel) / 8;
+
+    for (uint32_t y = y0; y + rows < y1; y++)
+    {
+        if (bytes)
+        {
+            memmove(&buffer[((yOrigin + y) * stride) + byte],
+                    &buffer[((yOrigin + y + rows) * stride) + byte],
+                    bytes);
+        }
+
+        for (uint32_t x = x0; x < head; x++)
+        {
+            writeLevel(x, y, readLevel(x, y + rows));
+        }
+
+        for (uint32_t x = tail; x < x1; x++)
+        {
+            writeLevel(x, y, readLevel(x, y + rows));
+        }
+    }
+}
+
+void GrayFrameBuffer::blendSpan(uint16_t x, uint16_t y, const uint8_t* coverage, uint16_t count, uint8_t level)
+{
+    if ((y >= height) || (x >= width))
+    {
+        return;
+    }
+
+    if (x + count > width)
+    {
+        count = width - x;
+    }
+
+    uint8_t maximum = (1 << bitsPerPixel) - 1;
+    uint8_t scale = (bitsPerPixel == 4) ? 17 : 85;
+    uint8_t pixelsPerByte = 8 / bitsPerPixel;
+
+    /* fully covered bytes are all ink */
+    uint8_t ink = ((level * maximum) + 127) / 255;
+    uint8_t inkByte = ink * ((bitsPerPixel == 4) ? 0x11 : 0x55);
+
+    uint8_t* row = &buffer[(yOrigin + y) * stride];
+    uint32_t first = xOrigin + x;
+    uint32_t last = first + count;
+
+    /*  The row is blended one byte of packed pixels at a time, each byte
+        read and written once. Bytes without coverage are skipped and fully
+        covered ones are stored whole, which covers most of a glyph.
+    */
+    for (uint32_t pixel = first; pixel < last; )
+    {
+        uint32_t end = ((pixel / pixelsPerByte) + 1) * pixelsPerByte;
+
+        end = (end > last) ? last : end;
+
+        const uint8_t* alpha = &coverage[pixel - first];
+        uint32_t length = end - pixel;
+        bool empty = true;
+        bool full = (length == pixelsPerByte);
+
+        for (uint32_t index = 0; index < length; index++)
+        {
+            empty = empty && (alpha[index] == 0);
+            full = full && (alpha[index] == 255);
+        }
+
+        uint8_t* byte = &row[(pixel * bitsPerPixel) / 8];
+
+        if (full)
+        {
+            *byte = inkByte;
+        }
+        else if (!empty)
+        {
+            uint8_t value = *byte;
+
+            for (uint32_t index = 0; index < length; index++)
+            {
+                uint32_t shift = 8 - bitsPerPixel - (((pixel + index) * bitsPerPixel) % 8);
+                uint8_t blended = glyphBlendPixel(((value >> shift) & maximum) * scale,
+                                                  alpha[index], level);
+
+                value = (value & ~(maximum << shift)) |
+                        ((((blended * maximum) + 127) / 255) << shift);
+            }
+
+            *byte = value;
+        }
+
+        pixel = end;
+    }
+}
+
+#endif // WATCH_FACE_GRAYSCALE
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/MenuLabel.h"
+
+#if WATCH_FACE_GLYPH_PACK
+#include "uif-ui-watch-face-wrd/GlyphPack.h"
+#else
+#include "UIFramework/UITextView.h"
+#endif
+
+#if MENU_LABEL_CACHE
+#include "uif-ui-watch-face-wrd/GlyphPack.h"
+
+#include <cstring>
+
+#define CACHE_ENTRIES ((MENU_LABEL_CACHE + 127) / 128)
+
+typedef struct {
+    glyph_pack_entry_t entry;   // offset into cacheData, label NULL if unused
+    char label[MENU_LABEL_SIZE];
+    menu_font_t font;
+    uint32_t lastUse;
+} cache_entry_t;
+
+static cache_entry_t cacheEntries[CACHE_ENTRIES];
+static uint8_t cacheData[MENU_LABEL_CACHE];
+static const glyph_pack_t cachePack = { 0, NULL, cacheData };
+static uint32_t cacheUsed = 0;
+static uint32_t cacheUses = 0;
+static MenuLabelCache::statistics_t cacheStatistics;
+
+/*  1 bpp canvas over a cached bitmap, for rasterizing labels into the
+    cache. Laid out as GLYPH_FORMAT_BITMAP, a set bit is ink, i.e., color 0.
+*/
+class LabelFrameBuffer : public FrameBuffer
+{
+public:
+    LabelFrameBuffer(uint8_t* _bits, uint16_t _stride, uint16_t _xOrigin, uint16_t _yOrigin,
+                     uint16_t _width, uint16_t _height)
+        :   bits(_bits),
+            stride(_stride),
+            xOrigin(_xOrigin),
+            yOrigin(_yOrigin),
+            width(_width),
+            height(_height)
+    {
+    }
+
+    virtual void drawPixel(uint16_t x, uint16_t y, uint8_t color)
+    {
+        if ((x < width) && (y < height))
+        {
+            uint8_t* byte = &bits[(yOrigin + y) * stride + (xOrigin + x) / 8];
+            uint8_t mask = 0x80 >> ((xOrigin + x) % 8);
+
+            *byte = (color) ? (*byte & ~mask) : (*byte | mask);
+        }
+    }
+
+    virtual uint8_t getPixel(uint16_t x, uint16_t y) const
+    {
+        if ((x < width) && (y < height))
+        {
+            uint8_t mask = 0x80 >> ((xOrigin + x) % 8);
+
+            return (bits[(yOrigin + y) * stride + (xOrigin + x) / 8] & mask) ? 0 : 1;
+        }
+
+        return 0;
+    }
+
+    virtual void drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color)
+    {
+        for (uint16_t y = y0; (y < y1) && (y < height); y++)
+        {
+            for (uint16_t x = x0; (x < x1) && (x < width); x++)
+            {
+                drawPixel(x, y, color);
+            }
+        }
+    }
+
+    virtual uint16_t getWidth() const
+    {
+        return width;
+    }
+
+    virtual uint16_t getHeight() const
+    {
+        return height;
+    }
+
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(int16_t x, int16_t y, uint16_t _width, uint16_t _height)
+    {
+        /* clip the window to this one */
+        int32_t x0 = (x > 0) ? x : 0;
+        int32_t y0 = (y > 0) ? y : 0;
+        int32_t x1 = ((x + _width) < width) ? (x + _width) : width;
+        int32_t y1 = ((y + _height) < height) ? (y + _height) : height;
+
+        x1 = (x1 > x0) ? x1 : x0;
+        y1 = (y1 > y0) ? y1 : y0;
+
+        return SharedPointer<FrameBuffer>(new LabelFrameBuffer(bits, stride, xOrigin + x0, yOrigin + y0,
+                                                             x1 - x0, y1 - y0));
+    }
+
+private:
+    uint8_t* bits;
+    uint16_t stride;
+    uint16_t xOrigin;
+    uint16_t yOrigin;
+    uint16_t width;
+    uint16_t height;
+};
+
+static UITextView* createTextView(const char* label, menu_font_t font)
+{
+    switch (font)
+    {
+        case MENU_FONT_MENU:
+        default:
+                return new UITextView(label, &Font_Menu);
+    }
+}
+#endif
+
+
+UIView* createMenuLabel(const char* label, const bool* gray)
+{
+#if WATCH_FACE_GLYPH_PACK
+    GlyphPackView* view = new GlyphPackView(&GlyphPack_Menu, label);
+
+    view->setGrayCanvas(gray);
+
+    return view;
+#elif MENU_LABEL_CACHE
+    (void) gray;
+
+    /* rasterized once, drawn from the cache after */
+    const glyph_pack_entry_t* entry = MenuLabelCache::find(label, MENU_FONT_MENU);
+
+    if (entry == NULL)
+    {
+        entry = MenuLabelCache::insert(label, MENU_FONT_MENU);
+    }
+
+    if (entry)
+    {
+        return new MenuLabelView(label, MENU_FONT_MENU, entry);
+    }
+
+    return new UITextView(label, &Font_Menu);
+#else
+    (void) gray;
+
+    return new UITextView(label, &Font_Menu);
+#endif
+}
+
+#if MENU_LABEL_CACHE
+/*****************************************************************************/
+/* Cache                                                                     */
+/*****************************************************************************/
+
+static void evict(cache_entry_t* victim)
+{
+    uint32_t offset = victim->entry.offset;
+    uint32_t size = ((victim->entry.width + 7) / 8) * victim->entry.height;
+
+    /* keep the bitmaps packed, so free space is always at the end */
+    memmove(&cacheData[offset], &cacheData[offset + size], cacheUsed - offset - size);
+
+    for (uint32_t slot = 0; slot < CACHE_ENTRIES; slot++)
+    {
+        if (cacheEntries[slot].entry.label && (cacheEntries[slot].entry.offset > offset))
+        {
+            cacheEntries[slot].entry.offset -= size;
+        }
+    }
+
+    victim->entry.label = NULL;
+    cacheUsed -= size;
+
+    cacheStatistics.evictions++;
+    cacheStatistics.entries--;
+    cacheStatistics.bytes = cacheUsed;
+}
+
+const glyph_pack_entry_t* MenuLabelCache::find(const char* label, menu_font_t font, bool hit)
+{
+    for (uint32_t slot = 0; slot < CACHE_ENTRIES; slot++)
+    {
+        cache_entry_t* cached = &cacheEntries[slot];
+
+        if (cached->entry.label && (cached->font == font) && (strcmp(cached->label, label) == 0))
+        {
+            cached->lastUse = ++cacheUses;
+
+            if (hit)
+            {
+                cacheStatistics.hits++;
+            }
+
+            return &cached->entry;
+        }
+    }
+
+    return NULL;
+}
+
+bool MenuLabelCache::contains(const glyph_pack_entry_t* entry, const char* label, menu_font_t font)
+{
+    /* entries are the first member of their slot */
+    const cache_entry_t* cached = reinterpret_cast<const cache_entry_t*>(entry);
+
+    return cached->entry.label && (cached->font == font) && (strcmp(cached->label, label) == 0);
+}
+
+const glyph_pack_entry_t* MenuLabelCache::insert(const char* label, menu_font_t font, uint32_t keepSince)
+{
+    if (strlen(label) >= MENU_LABEL_SIZE)
+    {
+        cacheStatistics.rejected++;
+
+        return NULL;
+    }
+
+    UITextView* view = createTextView(label, font);
+
+    uint32_t width = view->getWidth();
+    uint32_t height = view->getHeight();
+    uint32_t size = ((width + 7) / 8) * height;
+
+    /* evict the least recently used labels until the new one fits */
+    cache_entry_t* slot = NULL;
+
+    while (size <= MENU_LABEL_CACHE)
+    {
+        cache_entry_t* victim = NULL;
+        slot = NULL;
+
+        for (uint32_t index = 0; index < CACHE_ENTRIES; index++)
+        {
+            cache_entry_t* cached = &cacheEntries[index];
+
+            if (cached->entry.label == NULL)
+            {
+                slot = (slot) ? slot : cached;
+            }
+            else if ((victim == NULL) || (cached->lastUse < victim->lastUse))
+            {
+                victim = cached;
+            }
+        }
+
+        if (slot && ((cacheUsed + size) <= MENU_LABEL_CACHE))
+        {
+            break;
+        }
+
+        if ((victim == NULL) || (victim->lastUse >= keepSince))
+        {
+            slot = NULL;
+            break;
+        }
+
+        evict(victim);
+    }
+
+    if (slot == NULL)
+    {
+        delete view;
+        cacheStatistics.rejected++;
+
+        return NULL;
+    }
+
+    strcpy(slot->label, label);
+    slot->font = font;
+    slot->lastUse = ++cacheUses;
+
+    slot->entry.label = slot->label;
+    slot->entry.offset = cacheUsed;
+    slot->entry.width = width;
+    slot->entry.height = height;
+    slot->entry.format = GLYPH_FORMAT_BITMAP;
+
+    memset(&cacheData[cacheUsed], 0, size);
+
+    SharedPointer<FrameBuffer> canvas(new LabelFrameBuffer(&cacheData[cacheUsed], (width + 7) / 8, 0, 0,
+                                                           width, height));
+    view->fillFrameBuffer(canvas, 0, 0);
+
+    delete view;
+
+    cacheUsed += size;
+
+    cacheStatistics.misses++;
+    cacheStatistics.entries++;
+    cacheStatistics.bytes = cacheUsed;
+
+    return &slot->entry;
+}
+
+const glyph_pack_t* MenuLabelCache::getPack()
+{
+    return &cachePack;
+}
+
+uint32_t MenuLabelCache::getUseCount()
+{
+    return cacheUses;
+}
+
+const MenuLabelCache::statistics_t& MenuLabelCache::getStatistics()
+{
+    return cacheStatistics;
+}
+
+void MenuLabelCache::clear()
+{
+    for (uint32_t slot = 0; slot < CACHE_ENTRIES; slot++)
+    {
+        cacheEntries[slot].entry.label = NULL;
+    }
+
+    cacheUsed = 0;
+
+    cacheStatistics.entries = 0;
+    cacheStatistics.bytes = 0;
+}
+
+/*****************************************************************************/
+/* View                                                                      */
+/*****************************************************************************/
+
+MenuLabelView::MenuLabelView(const char* _label, menu_font_t _font, const glyph_pack_entry_t* _entry)
+    :   UIView(),
+        font(_font),
+        entry(_entry)
+{
+    strcpy(label, _label);
+
+    UIView::width = entry->width;
+    UIView::height = entry->height;
+}
+
+uint32_t MenuLabelView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
+                                        int16_t xOffset,
+                                        int16_t yOffset)
+{
+    /* look the label up again only if it was evicted, redraws are not uses */
+    if ((entry == NULL) || !MenuLabelCache::contains(entry, label, font))
+    {
+        entry = MenuLabelCache::find(label, font, false);
+
+        if (entry == NULL)
+        {
+            entry = MenuLabelCache::insert(label, font);
+        }
+    }
+
+    if (entry)
+    {
+        glyphPackDraw(MenuLabelCache::getPack(), entry, canvas, xOffset, yOffset, false);
+    }
+
+    return 0xFFFFFFFF;
+}
+#endif
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/MenuTable.h"
+
+#include "UIFramework/UIImageView.h"
+
+#include "uif-ui-watch-face-wrd/MenuLabel.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "uif-ui-watch-face-wrd/WatchFaceFrameGovernor.h"
+
+#if WATCH_FACE_GLYPH_PACK || MENU_LABEL_CACHE
+#include "uif-ui-watch-face-wrd/GlyphPack.h"
+#endif
+
+#if WATCH_FACE_GLYPH_PACK && WATCH_FACE_GRAYSCALE
+#include "uif-ui-watch-face-wrd/GrayFrameBuffer.h"
+#endif
+
+#if !WATCH_FACE_GLYPH_PACK
+#include "UIFramework/UITextView.h"
+#endif
+
+#include <cstring>
+
+#if WATCH_FACE_FRAME_PROFILE == WATCH_FACE_PROFILE_LOW_POWER
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_LOW_POWER
+#else
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_SMOOTH
+#endif
+
+MenuTable::MenuTable()
+    :   UIView::Array()
+{
+    memset(&statistics, 0, sizeof(statistics_t));
+    grayCanvas = false;
+
+#if MENU_LABEL_CACHE
+    frameStart = 0;
+#endif
+}
+
+SharedPointer<UIView> MenuTable::viewAtIndex(uint32_t index) const
+{
+    UIView* cell = NULL;
+
+    if (index < getSize())
+    {
+        char buffer[MENU_LABEL_SIZE];
+        const char* label = labelAtIndex(index, buffer);
+
+        if (label)
+        {
+            cell = createMenuLabel(label, &grayCanvas);
+        }
+        else
+        {
+            cell = new UIImageView(NULL);
+        }
+    }
+
+    if (cell)
+    {
+        cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
+        cell->setVerticalAlignment(UIView::VALIGN_MIDDLE);
+        cell->setWidth(0);
+        cell->setHeight(0);
+    }
+
+    return SharedPointer<UIView>(cell);
+}
+
+uint32_t MenuTable::widthAtIndex(uint32_t index) const
+{
+    (void) index;
+
+    return WATCH_FACE_PANEL_WIDTH;
+}
+
+uint32_t MenuTable::heightAtIndex(uint32_t index) const
+{
+    uint32_t ret = 0;
+
+    if ( (index == 0) || (index == (getSize() - 1)) )
+    {
+        ret = getFillerHeight();
+    }
+    else
+    {
+        ret = WATCH_FACE_MENU_ROW_HEIGHT;
+    }
+
+    return ret;
+}
+
+uint32_t MenuTable::getFillerHeight() const
+{
+    return WATCH_FACE_PANEL_HEIGHT;
+}
+
+uint32_t MenuTable::rowHeight(uint32_t index, uint32_t size, uint32_t filler) const
+{
+    return ((index == 0) || (index == (size - 1))) ? filler : WATCH_FACE_MENU_ROW_HEIGHT;
+}
+
+uint32_t MenuTable::rowAtOffset(uint32_t offset, uint32_t filler, int32_t* top) const
+{
+    /*  Rows have a fixed height apart from the fillers, so the row is
+        known without summing the heights above it.
+    */
+    if (offset < filler)
+    {
+        *top = -(int32_t) offset;
+
+        return 0;
+    }
+
+    *top = -(int32_t) ((offset - filler) % WATCH_FACE_MENU_ROW_HEIGHT);
+
+    return 1 + (offset - filler) / WATCH_FACE_MENU_ROW_HEIGHT;
+}
+
+uint32_t MenuTable::fillVisibleRows(SharedPointer<FrameBuffer>& strip, uint32_t scrollOffset,
+                                    int16_t xOffset)
+{
+    uint32_t start = UIView::getTimeInMilliseconds();
+
+    uint32_t size = getSize();
+    uint32_t filler = getFillerHeight();
+    int32_t viewport = strip->getHeight();
+
+    /* labels are black on white, as drawn by the views */
+    strip->drawRectangle(0, strip->getWidth(), 0, viewport, 1);
+
+#if MENU_LABEL_CACHE
+    /* labels drawn in this frame are not evicted for others */
+    frameStart = MenuLabelCache::getUseCount() + 1;
+#endif
+
+#if WATCH_FACE_GLYPH_PACK && WATCH_FACE_GRAYSCALE
+    /* the owner vouches for the strip, see setGrayCanvas */
+    GrayFrameBuffer* gray = (grayCanvas) ? static_cast<GrayFrameBuffer*>(strip.get()) : NULL;
+#elif WATCH_FACE_GLYPH_PACK
+    GrayFrameBuffer* gray = NULL;
+#endif
+
+    int32_t top;
+    uint32_t first = rowAtOffset(scrollOffset, filler, &top);
+
+    uint32_t drawn = 0;
+
+    for (uint32_t index = first; (top < viewport) && (index < size); index++)
+    {
+        uint32_t height = rowHeight(index, size, filler);
+
+        char buffer[MENU_LABEL_SIZE];
+        const char* label = labelAtIndex(index, buffer);
+
+        if (label)
+        {
+#if WATCH_FACE_GLYPH_PACK
+            const glyph_pack_entry_t* entry = glyphPackFind(&GlyphPack_Menu, label);
+
+            if (entry)
+            {
+                int32_t y = top + ((int32_t) height - entry->height) / 2;
+
+                glyphPackDrawInk(&GlyphPack_Menu, entry, strip, xOffset, y, false, gray);
+                drawn++;
+            }
+#elif MENU_LABEL_CACHE
+            const glyph_pack_entry_t* entry = MenuLabelCache::find(label, MENU_FONT_MENU);
+
+            if (entry)
+            {
+                statistics.hits++;
+            }
+            else
+            {
+                statistics.misses++;
+
+                entry = MenuLabelCache::insert(label, MENU_FONT_MENU, frameStart);
+            }
+
+            if (entry)
+            {
+                int32_t y = top + ((int32_t) height - entry->height) / 2;
+
+                glyphPackDrawInk(MenuLabelCache::getPack(), entry, strip, xOffset, y, false);
+                drawn++;
+            }
+            else if (drawLabel(label, strip, xOffset, top, height))
+            {
+                drawn++;
+            }
+#else
+            if (drawLabel(label, strip, xOffset, top, height))
+            {
+                drawn++;
+            }
+#endif
+        }
+
+        top += height;
+    }
+
+    statistics.frames++;
+
+    if ((UIView::getTimeInMilliseconds() - start) > FRAME_PROFILE.minimumInterval)
+    {
+        statistics.droppedFrames++;
+    }
+
+    return drawn;
+}
+
+uint32_t MenuTable::prefetchRows(uint32_t scrollOffset, uint32_t viewportHeight,
+                                 int32_t direction, uint32_t budget)
+{
+    uint32_t rendered = 0;
+
+#if MENU_LABEL_CACHE
+    uint32_t start = UIView::getTimeInMilliseconds();
+
+    uint32_t size = getSize();
+    uint32_t filler = getFillerHeight();
+
+    int32_t top;
+    uint32_t first = rowAtOffset(scrollOffset, filler, &top);
+    uint32_t last = rowAtOffset(scrollOffset + viewportHeight - 1, filler, &top);
+
+    uint32_t rows = viewportHeight / WATCH_FACE_MENU_ROW_HEIGHT + 1;
+
+    for (uint32_t ahead = 1; ahead <= rows; ahead++)
+    {
+        uint32_t index;
+
+        if (direction >= 0)
+        {
+            index = last + ahead;
+
+            if (index >= size)
+            {
+                break;
+            }
+        }
+        else
+        {
+            if (first < ahead)
+            {
+                break;
+            }
+
+            index = first - ahead;
+        }
+
+        char buffer[MENU_LABEL_SIZE];
+        const char* label = labelAtIndex(index, buffer);
+
+        /* labels already cached are kept, but not counted as hits */
+        if ((label == NULL) || MenuLabelCache::find(label, MENU_FONT_MENU, false))
+        {
+            continue;
+        }
+
+        if ((UIView::getTimeInMilliseconds() - start) >= budget)
+        {
+            statistics.budgetStops++;
+            break;
+        }
+
+        /* the rows just drawn and those prefetched before are kept */
+        if (MenuLabelCache::insert(label, MENU_FONT_MENU, frameStart) == NULL)
+        {
+            break;
+        }
+
+        statistics.prefetched++;
+        rendered++;
+    }
+#else
+    (void) scrollOffset;
+    (void) viewportHeight;
+    (void) direction;
+    (void) budget;
+#endif
+
+    return rendered;
+}
+
+#if !WATCH_FACE_GLYPH_PACK
+bool MenuTable::drawLabel(const char* label, SharedPointer<FrameBuffer>& strip, int16_t xOffset,
+                          int32_t top, uint32_t height)
+{
+    /* not cached, render the label as a UITextView would */
+    UIView* cell = new UITextView(label, &Font_Menu);
+
+    int32_t viewport = strip->getHeight();
+    int32_t y = top + ((int32_t) height - (int32_t) cell->getHeight()) / 2;
+    int32_t width = (int32_t) cell->getWidth() + xOffset;
+
+    /* rows above the viewport are clipped through the camera offset */
+    int32_t clip = (y < 0) ? y : 0;
+    int32_t visible = (int32_t) cell->getHeight() + clip;
+
+    y -= clip;
+
+    if (y + visible > viewport)
+    {
+        visible = viewport - y;
+    }
+
+    if ((visible > 0) && (width > 0))
+    {
+        SharedPointer<FrameBuffer> canvas = strip->getFrameBuffer(0, y, width, visible);
+
+        cell->fillFrameBuffer(canvas, xOffset, clip);
+    }
+
+    delete cell;
+
+    return (visible > 0) && (width > 0);
+}
+#endif
+
+void MenuTable::setGrayCanvas(bool gray)
+{
+    grayCanvas = gray;
+}
+
+const MenuTable::statistics_t& MenuTable::getStatistics() const
+{
+    return statistics;
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/MenuTableView.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "uif-ui-watch-face-wrd/WatchFaceFrameGovernor.h"
+
+#if WATCH_FACE_FRAME_PROFILE == WATCH_FACE_PROFILE_LOW_POWER
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_LOW_POWER
+#else
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_SMOOTH
+#endif
+
+MenuTableView::MenuTableView(SharedPointer<MenuTable> _table)
+    :   UIView(),
+        table(_table),
+        scrollOffset(0),
+        drawnOffset(0),
+        direction(1)
+{
+    /* Default size unless overwritten by parent. */
+    UIView::width = WATCH_FACE_PANEL_WIDTH;
+    UIView::height = WATCH_FACE_PANEL_HEIGHT;
+}
+
+uint32_t MenuTableView::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
+                                        int16_t xOffset,
+                                        int16_t yOffset)
+{
+    uint32_t start = UIView::getTimeInMilliseconds();
+
+    /* rows clipped at the top through the camera are further down the table */
+    int32_t shifted = (int32_t) scrollOffset - yOffset;
+    uint32_t offset = (shifted > 0) ? shifted : 0;
+
+    table->fillVisibleRows(canvas, offset, xOffset);
+
+    bool moving = (scrollOffset != drawnOffset);
+
+    if (moving)
+    {
+        direction = (scrollOffset > drawnOffset) ? 1 : -1;
+        drawnOffset = scrollOffset;
+    }
+
+    /*  The rest of the frame is idle. It goes to the rows the table is
+        moving towards, even after it has stopped, since a flick is often
+        followed by another in the same direction.
+    */
+    uint32_t elapsed = UIView::getTimeInMilliseconds() - start;
+
+    if (elapsed < FRAME_PROFILE.minimumInterval)
+    {
+        table->prefetchRows(offset, canvas->getHeight(), direction,
+                            FRAME_PROFILE.minimumInterval - elapsed);
+    }
+
+    return (moving) ? FRAME_PROFILE.minimumInterval : 0xFFFFFFFF;
+}
+
+void MenuTableView::setScrollOffset(uint32_t offset)
+{
+    scrollOffset = offset;
+}
+
+uint32_t MenuTableView::getScrollOffset() const
+{
+    return scrollOffset;
+}
+
+SharedPointer<MenuTable> MenuTableView::getTable()
+{
+    return table;
+}
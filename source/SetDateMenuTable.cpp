@@ -19,36 +19,22 @@
 
 #include "mbed-time/Calendar.h"
 
-#include "UIFramework/UITextView.h"
-#include "UIFramework/UIImageView.h"
-
 
 extern const char* numberStringDouble[];
 
-SharedPointer<UIView> SetDateMenuTable::viewAtIndex(uint32_t index) const
+const char* SetDateMenuTable::labelAtIndex(uint32_t index, char* buffer) const
 {
-    uint8_t days = Calendar::getDaysInMonth();
-
-    UIView* cell = NULL;
+    (void) buffer;
 
-    if ( (index == 0) || (index == (days + 1u)) )
-    {
-        cell = new UIImageView(NULL);
-    }
-    else if (index <= days)
-    {
-        cell = new UITextView(numberStringDouble[index], &Font_Menu);
-    }
+    uint8_t days = Calendar::getDaysInMonth();
+    const char* label = NULL;
 
-    if (cell)
+    if ( (index != 0) && (index <= days) )
     {
-        cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
-        cell->setVerticalAlignment(UIView::VALIGN_MIDDLE);
-        cell->setWidth(0);
-        cell->setHeight(0);
+        label = numberStringDouble[index];
     }
 
-    return SharedPointer<UIView>(cell);
+    return label;
 }
 
 uint32_t SetDateMenuTable::getSize() const
@@ -58,31 +44,6 @@ uint32_t SetDateMenuTable::getSize() const
     return days + 2;
 }
 
-uint32_t SetDateMenuTable::widthAtIndex(uint32_t index) const
-{
-    (void) index;
-
-    return 128;
-}
-
-uint32_t SetDateMenuTable::heightAtIndex(uint32_t index) const
-{
-    uint8_t days = Calendar::getDaysInMonth();
-
-    uint32_t ret = 0;
-
-    if ( (index == 0) || (index == (days + 1u)) )
-    {
-        ret = 128;
-    }
-    else
-    {
-        ret = 35;
-    }
-
-    return ret;
-}
-
 SharedPointer<UIView::Action> SetDateMenuTable::actionAtIndex(uint32_t index)
 {
     Calendar::setDate(index);
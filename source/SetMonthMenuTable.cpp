@@ -19,9 +19,6 @@
 
 #include "mbed-time/Calendar.h"
 
-#include "UIFramework/UITextView.h"
-#include "UIFramework/UIImageView.h"
-
 
 typedef enum {
     CELL_TOP_FILLER = 0, // Always first
@@ -47,28 +44,18 @@ static const char * month[] = {
 };
 
 
-SharedPointer<UIView> SetMonthMenuTable::viewAtIndex(uint32_t index) const
+const char* SetMonthMenuTable::labelAtIndex(uint32_t index, char* buffer) const
 {
-    UIView* cell = NULL;
+    (void) buffer;
 
-    if ( (index == CELL_TOP_FILLER) || (index == CELL_END_FILLER) )
-    {
-        cell = new UIImageView(NULL);
-    }
-    else if (index < CELL_END_FILLER)
-    {
-        cell = new UITextView(month[index - 1], &Font_Menu);
-    }
+    const char* label = NULL;
 
-    if (cell)
+    if ( (index != CELL_TOP_FILLER) && (index < CELL_END_FILLER) )
     {
-        cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
-        cell->setVerticalAlignment(UIView::VALIGN_MIDDLE);
-        cell->setWidth(0);
-        cell->setHeight(0);
+        label = month[index - 1];
     }
 
-    return SharedPointer<UIView>(cell);
+    return label;
 }
 
 uint32_t SetMonthMenuTable::getSize() const
@@ -76,29 +63,6 @@ uint32_t SetMonthMenuTable::getSize() const
     return CELL_END_FILLER + 1;
 }
 
-uint32_t SetMonthMenuTable::widthAtIndex(uint32_t index) const
-{
-    (void) index;
-
-    return 128;
-}
-
-uint32_t SetMonthMenuTable::heightAtIndex(uint32_t index) const
-{
-    uint32_t ret = 0;
-
-    if ( (index == CELL_TOP_FILLER) || (index == CELL_END_FILLER) )
-    {
-        ret = 128;
-    }
-    else
-    {
-        ret = 35;
-    }
-
-    return ret;
-}
-
 SharedPointer<UIView::Action> SetMonthMenuTable::actionAtIndex(uint32_t index)
 {
     Calendar::setMonth(index);
@@ -17,9 +17,6 @@
 
 #include "uif-ui-watch-face-wrd/SetTimeMenuTable.h"
 
-#include "UIFramework/UITextView.h"
-#include "UIFramework/UIImageView.h"
-
 #include "uif-ui-watch-face-wrd/SetHourMenuTable.h"
 #include "uif-ui-watch-face-wrd/SetMinuteMenuTable.h"
 #include "uif-ui-watch-face-wrd/SetDateMenuTable.h"
@@ -127,52 +124,39 @@ typedef enum {
     CELL_END_FILLER
 } entries_t;
 
-SharedPointer<UIView> SetTimeMenuTable::viewAtIndex(uint32_t index) const
+const char* SetTimeMenuTable::labelAtIndex(uint32_t index, char* buffer) const
 {
-    UIView* cell = NULL;
+    (void) buffer;
+
+    const char* label = NULL;
 
     switch(index)
     {
-        case CELL_TOP_FILLER:
-                // top filler
-                cell = new UIImageView(NULL);
-                break;
-
         // time
         case CELL_HOUR:
-                cell = new UITextView("Hour", &Font_Menu);
+                label = "Hour";
                 break;
         case CELL_MINUTE:
-                cell = new UITextView("Minute", &Font_Menu);
+                label = "Minute";
                 break;
 
         // date
         case CELL_DATE:
-                cell = new UITextView("Date", &Font_Menu);
+                label = "Date";
                 break;
         case CELL_MONTH:
-                cell = new UITextView("Month", &Font_Menu);
+                label = "Month";
                 break;
         case CELL_YEAR:
-                cell = new UITextView("Year", &Font_Menu);
+                label = "Year";
                 break;
 
-        case CELL_END_FILLER:
+        // fillers
         default:
-                // bottom filler
-                cell = new UIImageView(NULL);
                 break;
     }
 
-    if (cell)
-    {
-        cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
-        cell->setVerticalAlignment(UIView::VALIGN_MIDDLE);
-        cell->setWidth(0);
-        cell->setHeight(0);
-    }
-
-    return SharedPointer<UIView>(cell);
+    return label;
 }
 
 uint32_t SetTimeMenuTable::getSize() const
@@ -180,29 +164,6 @@ uint32_t SetTimeMenuTable::getSize() const
     return CELL_END_FILLER + 1;
 }
 
-uint32_t SetTimeMenuTable::widthAtIndex(uint32_t index) const
-{
-    (void) index;
-
-    return 128;
-}
-
-uint32_t SetTimeMenuTable::heightAtIndex(uint32_t index) const
-{
-    uint32_t ret = 0;
-
-    if ( (index == CELL_TOP_FILLER) || (index == CELL_END_FILLER) )
-    {
-        ret = 128;
-    }
-    else
-    {
-        ret = 35;
-    }
-
-    return ret;
-}
-
 SharedPointer<UIView::Action> SetTimeMenuTable::actionAtIndex(uint32_t index)
 {
     UIView::Array* table = NULL;
@@ -19,8 +19,7 @@
 
 #include "mbed-time/Calendar.h"
 
-#include "UIFramework/UITextView.h"
-#include "UIFramework/UIImageView.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
 
 #include <cstdio>
 
@@ -59,34 +58,19 @@ const char* yearStringQuadruple[] = {
     "2038"
 };
 
-SharedPointer<UIView> SetYearMenuTable::viewAtIndex(uint32_t index) const
+const char* SetYearMenuTable::labelAtIndex(uint32_t index, char* buffer) const
 {
-    UIView* cell = NULL;
+    const char* label = NULL;
 
     /*  POSIX time starts in 1970.
     */
-    if (index < 1970)
+    if (index >= 1970)
     {
-        cell = new UIImageView(NULL);
-    }
-    else
-    {
-        char yearArray[5];
-        snprintf(yearArray, 5, "%4d", (int) index);
-        std::string yearString(yearArray);
-
-        cell = new UITextView(yearString, &Font_Menu);
-    }
-
-    if (cell)
-    {
-        cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
-        cell->setVerticalAlignment(UIView::VALIGN_MIDDLE);
-        cell->setWidth(0);
-        cell->setHeight(0);
+        snprintf(buffer, 5, "%4d", (int) index);
+        label = buffer;
     }
 
-    return SharedPointer<UIView>(cell);
+    return label;
 }
 
 uint32_t SetYearMenuTable::getSize() const
@@ -94,18 +78,10 @@ uint32_t SetYearMenuTable::getSize() const
     return 9999;
 }
 
-uint32_t SetYearMenuTable::widthAtIndex(uint32_t index) const
+uint32_t SetYearMenuTable::getFillerHeight() const
 {
-    (void) index;
-
-    return 128;
-}
-
-uint32_t SetYearMenuTable::heightAtIndex(uint32_t index) const
-{
-    (void) index;
-
-    return 35;
+    /* the years before 1970 are blank rows, there are no fillers */
+    return WATCH_FACE_MENU_ROW_HEIGHT;
 }
 
 SharedPointer<UIView::Action> SetYearMenuTable::actionAtIndex(uint32_t index)
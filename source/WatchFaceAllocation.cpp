@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceAllocation.h"
+
+#include <cstdlib>
+
+WatchFaceAllocationScope* WatchFaceAllocationScope::innermost = NULL;
+
+WatchFaceAllocationScope::WatchFaceAllocationScope()
+    :   outer(innermost),
+        allocations(0),
+        releases(0),
+        bytes(0),
+        siteCount(0)
+{
+    innermost = this;
+}
+
+WatchFaceAllocationScope::~WatchFaceAllocationScope()
+{
+    /* scopes close in the reverse order of opening */
+    innermost = outer;
+}
+
+uint32_t WatchFaceAllocationScope::getAllocations() const
+{
+    return allocations;
+}
+
+uint32_t WatchFaceAllocationScope::getReleases() const
+{
+    return releases;
+}
+
+uint32_t WatchFaceAllocationScope::getBytes() const
+{
+    return bytes;
+}
+
+uint32_t WatchFaceAllocationScope::getSites() const
+{
+    return siteCount;
+}
+
+const WatchFaceAllocationScope::site_t& WatchFaceAllocationScope::getSite(uint32_t index) const
+{
+    return sites[index];
+}
+
+void WatchFaceAllocationScope::recordAllocation(size_t size, const void* site)
+{
+    for (WatchFaceAllocationScope* scope = innermost; scope; scope = scope->outer)
+    {
+        scope->allocations++;
+        scope->bytes += size;
+
+        uint32_t index = 0;
+
+        while ((index < scope->siteCount) && (scope->sites[index].site != site))
+        {
+            index++;
+        }
+
+        if ((index == scope->siteCount) && (index < WATCH_FACE_ALLOCATION_SITES))
+        {
+            scope->sites[index].site = site;
+            scope->sites[index].allocations = 0;
+            scope->sites[index].bytes = 0;
+            scope->siteCount++;
+        }
+
+        if (index < scope->siteCount)
+        {
+            scope->sites[index].allocations++;
+            scope->sites[index].bytes += size;
+        }
+    }
+}
+
+void WatchFaceAllocationScope::recordRelease()
+{
+    for (WatchFaceAllocationScope* scope = innermost; scope; scope = scope->outer)
+    {
+        scope->releases++;
+    }
+}
+
+/*****************************************************************************/
+/* Hook                                                                      */
+/*****************************************************************************/
+
+#if WATCH_FACE_ALLOCATION_HOOK
+void* operator new(size_t size)
+{
+    WatchFaceAllocationScope::recordAllocation(size, __builtin_return_address(0));
+
+    return malloc((size > 0) ? size : 1);
+}
+
+void* operator new[](size_t size)
+{
+    WatchFaceAllocationScope::recordAllocation(size, __builtin_return_address(0));
+
+    return malloc((size > 0) ? size : 1);
+}
+
+void operator delete(void* pointer)
+{
+    if (pointer)
+    {
+        WatchFaceAllocationScope::recordRelease();
+        free(pointer);
+    }
+}
+
+void operator delete[](void* pointer)
+{
+    if (pointer)
+    {
+        WatchFaceAllocationScope::recordRelease();
+        free(pointer);
+    }
+}
+#endif
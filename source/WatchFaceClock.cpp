@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceClock.h"
+
+#include "mbed-time/Calendar.h"
+
+#include "UIFramework/UIView.h"
+
+#define MILLISECONDS_PER_DAY (24UL * 60 * 60 * 1000)
+
+/*****************************************************************************/
+/* Calendar                                                                  */
+/*****************************************************************************/
+
+void WatchFaceCalendarClock::getTime(uint8_t* hour, uint8_t* minute, uint8_t* second)
+{
+    Calendar::getHour(hour, minute, second);
+}
+
+uint8_t WatchFaceCalendarClock::getDate()
+{
+    return Calendar::getDate();
+}
+
+uint8_t WatchFaceCalendarClock::getDay()
+{
+    return Calendar::getDay();
+}
+
+uint8_t WatchFaceCalendarClock::getDaysInMonth()
+{
+    return Calendar::getDaysInMonth();
+}
+
+uint32_t WatchFaceCalendarClock::getTimeInMilliseconds()
+{
+    return UIView::getTimeInMilliseconds();
+}
+
+/*****************************************************************************/
+/* Virtual                                                                   */
+/*****************************************************************************/
+
+WatchFaceVirtualClock::WatchFaceVirtualClock()
+    :   milliseconds(0),
+        millisecondOfDay(0),
+        day(0),
+        date(1)
+{
+}
+
+void WatchFaceVirtualClock::getTime(uint8_t* hour, uint8_t* minute, uint8_t* second)
+{
+    uint32_t seconds = millisecondOfDay / 1000;
+
+    *hour = seconds / 3600;
+    *minute = (seconds / 60) % 60;
+    *second = seconds % 60;
+}
+
+uint8_t WatchFaceVirtualClock::getDate()
+{
+    return date;
+}
+
+uint8_t WatchFaceVirtualClock::getDay()
+{
+    return day;
+}
+
+uint8_t WatchFaceVirtualClock::getDaysInMonth()
+{
+    /* same as advance, which has no notion of month */
+    return 31;
+}
+
+uint32_t WatchFaceVirtualClock::getTimeInMilliseconds()
+{
+    return milliseconds;
+}
+
+void WatchFaceVirtualClock::set(uint8_t _hour, uint8_t _minute, uint8_t _second,
+                                uint8_t _day, uint8_t _date)
+{
+    millisecondOfDay = ((_hour * 60UL + _minute) * 60UL + _second) * 1000UL;
+    day = _day;
+    date = _date;
+}
+
+void WatchFaceVirtualClock::setTimeInMilliseconds(uint32_t _milliseconds)
+{
+    milliseconds = _milliseconds;
+}
+
+void WatchFaceVirtualClock::advance(uint32_t increment)
+{
+    milliseconds += increment;
+    millisecondOfDay += increment;
+
+    while (millisecondOfDay >= MILLISECONDS_PER_DAY)
+    {
+        millisecondOfDay -= MILLISECONDS_PER_DAY;
+
+        day = (day + 1) % 7;
+        date = (date % 31) + 1;
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceFrameGovernor.h"
+
+#include <cstring>
+
+/*  SMOOTH: 20 fps with up to 100 ms of CPU per animation.
+    LOW_POWER: 12 fps with up to 25 ms of CPU per animation.
+*/
+const WatchFaceFrameGovernor::profile_t WatchFaceFrameGovernor::PROFILE_SMOOTH = { 50, 100 };
+const WatchFaceFrameGovernor::profile_t WatchFaceFrameGovernor::PROFILE_LOW_POWER = { 84, 25 };
+
+WatchFaceFrameGovernor::WatchFaceFrameGovernor(const profile_t& _profile)
+    :   profile(_profile),
+        budgetInterval(0),
+        frameStart(0),
+        frameDue(0),
+        pacing(false)
+{
+    memset(&statistics, 0, sizeof(statistics_t));
+
+    watchdog.frameBudget = (profile.minimumInterval * 2) / 5;
+    watchdog.overrunLimit = watchdog.frameBudget * 2;
+    watchdog.cpuLimit = (profile.animationBudget * 3) / 2;
+}
+
+void WatchFaceFrameGovernor::animationStarted(uint32_t duration)
+{
+    /*  Spread the CPU budget over the animation: with frames costing
+        frameCost each, the budget allows budget / frameCost frames.
+    */
+    if ((statistics.frameCost > 0) && (profile.animationBudget > 0))
+    {
+        uint32_t frames = profile.animationBudget / statistics.frameCost;
+
+        budgetInterval = (frames > 0) ? duration / frames : duration;
+    }
+    else
+    {
+        budgetInterval = 0;
+    }
+}
+
+void WatchFaceFrameGovernor::frameStarted(uint32_t now)
+{
+    frameStart = now;
+
+    /*  Time past the requested start is spent flushing the previous frame
+        or waiting for the CPU. Count it towards the previous frame's cost.
+    */
+    if (pacing)
+    {
+        int32_t late = (int32_t) (now - frameDue);
+
+        if (late > 0)
+        {
+            statistics.frameCost += late / 4;
+
+            if ((uint32_t) late > statistics.lastInterval)
+            {
+                statistics.overruns++;
+            }
+        }
+    }
+
+    pacing = false;
+}
+
+uint32_t WatchFaceFrameGovernor::frameFinished(uint32_t now, uint32_t remaining)
+{
+    /* running average, weighting the latest frame by 1/4 */
+    uint32_t cost = now - frameStart;
+
+    statistics.frameCost = (3 * statistics.frameCost + cost + 3) / 4;
+
+    /* never ask for frames faster than they can be produced */
+    uint32_t interval = profile.minimumInterval;
+
+    if (budgetInterval > interval)
+    {
+        interval = budgetInterval;
+    }
+
+    if (statistics.frameCost > interval)
+    {
+        interval = statistics.frameCost;
+    }
+
+    /*  Land the last frame exactly on the end of the animation instead of
+        showing a nearly finished frame and waiting another interval.
+    */
+    if (remaining < interval)
+    {
+        interval = (remaining > 0) ? remaining : 1;
+    }
+
+    statistics.frames++;
+    statistics.lastInterval = interval;
+
+    if ((statistics.shortestInterval == 0) || (interval < statistics.shortestInterval))
+    {
+        statistics.shortestInterval = interval;
+    }
+
+    if (interval > statistics.longestInterval)
+    {
+        statistics.longestInterval = interval;
+    }
+
+    pacing = true;
+    frameDue = now + interval;
+
+    return interval;
+}
+
+void WatchFaceFrameGovernor::idle()
+{
+    pacing = false;
+}
+
+const WatchFaceFrameGovernor::statistics_t& WatchFaceFrameGovernor::getStatistics() const
+{
+    return statistics;
+}
+
+const WatchFaceFrameGovernor::watchdog_t& WatchFaceFrameGovernor::getWatchdog() const
+{
+    return watchdog;
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceLayout.h"
+
+static void place(watch_face_rect_t* rect, int32_t x, int32_t y, const glyph_metrics_t& metrics)
+{
+    rect->x = x;
+    rect->y = y;
+    rect->width = metrics.width;
+    rect->height = metrics.height;
+}
+
+void WatchFaceLayout::calculate(const watch_face_metrics_t& metrics,
+                                const watch_face_time_t& time,
+                                uint16_t width,
+                                uint16_t height,
+                                layout_t* layout)
+{
+    const glyph_metrics_t& hour = metrics.hours[time.hour];
+    const glyph_metrics_t& minute_x0 = metrics.minutes[time.minute / 10];
+    const glyph_metrics_t& minute_0x = metrics.minutes[time.minute % 10];
+    const glyph_metrics_t& day = metrics.dayndate[time.day];
+    const glyph_metrics_t& date = metrics.dayndate[7 + time.date - 1];
+
+    layout->time = time;
+    layout->width = width;
+    layout->height = height;
+
+    /* center clock on screen. */
+    int32_t left_margin = ((int32_t) width - hour.width
+                                           - minute_x0.width
+                                           - minute_0x.width
+                                           - WATCH_FACE_CENTER_SPACE) / 2;
+
+    int32_t top_margin = ((int32_t) height - minute_x0.height) / 2;
+
+    place(&layout->hour, left_margin, top_margin, hour);
+
+    place(&layout->minute_x0,
+          left_margin + hour.width + WATCH_FACE_CENTER_SPACE,
+          top_margin,
+          minute_x0);
+
+    place(&layout->minute_0x,
+          layout->minute_x0.x + minute_x0.width + WATCH_FACE_MINUTE_KERNING,
+          top_margin + minute_x0.height - minute_0x.height,
+          minute_0x);
+
+    place(&layout->day,
+          left_margin,
+          top_margin + hour.height + WATCH_FACE_LINE_SPACE,
+          day);
+
+    place(&layout->date,
+          layout->day.x + day.width + WATCH_FACE_CENTER_SPACE,
+          layout->day.y,
+          date);
+}
+
+static bool merge(const watch_face_rect_t& from,
+                  const watch_face_rect_t& to,
+                  bool changed,
+                  watch_face_rect_t* region)
+{
+    if ((changed == false) &&
+        (from.x == to.x) && (from.y == to.y) &&
+        (from.width == to.width) && (from.height == to.height))
+    {
+        return false;
+    }
+
+    int32_t x0 = (from.x < to.x) ? from.x : to.x;
+    int32_t y0 = (from.y < to.y) ? from.y : to.y;
+    int32_t x1 = (from.x + from.width > to.x + to.width) ? from.x + from.width
+                                                         : to.x + to.width;
+    int32_t y1 = (from.y + from.height > to.y + to.height) ? from.y + from.height
+                                                           : to.y + to.height;
+
+    region->x = x0;
+    region->y = y0;
+    region->width = x1 - x0;
+    region->height = y1 - y0;
+
+    return true;
+}
+
+uint8_t WatchFaceLayout::damage(const layout_t& from, const layout_t& to, watch_face_rect_t* regions)
+{
+    uint8_t count = 0;
+
+    count += merge(from.hour, to.hour,
+                   from.time.hour != to.time.hour,
+                   &regions[count]);
+
+    count += merge(from.minute_x0, to.minute_x0,
+                   (from.time.minute / 10) != (to.time.minute / 10),
+                   &regions[count]);
+
+    count += merge(from.minute_0x, to.minute_0x,
+                   (from.time.minute % 10) != (to.time.minute % 10),
+                   &regions[count]);
+
+    count += merge(from.day, to.day,
+                   from.time.day != to.time.day,
+                   &regions[count]);
+
+    count += merge(from.date, to.date,
+                   from.time.date != to.time.date,
+                   &regions[count]);
+
+    return count;
+}
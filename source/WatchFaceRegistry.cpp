@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceRegistry.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+
+#include <cstring>
+
+/* Delay returned while there is no face to show. */
+#define EMPTY_DELAY_MS 1000
+
+WatchFaceRegistry::WatchFaceRegistry(SharedPointer<WatchFaceClock> _clock)
+    :   UIView(),
+        clock(_clock),
+        count(0),
+        face(NULL),
+        selected(-1)
+{
+    /* Default size unless overwritten by parent. */
+    UIView::width = WATCH_FACE_PANEL_WIDTH;
+    UIView::height = WATCH_FACE_PANEL_HEIGHT;
+
+    memset(&statistics, 0, sizeof(statistics_t));
+
+    statistics.inactiveLimit = MAX_WATCH_FACES * sizeof(watch_face_state_t);
+}
+
+WatchFaceRegistry::~WatchFaceRegistry()
+{
+    delete face;
+}
+
+int8_t WatchFaceRegistry::add(factory_t factory)
+{
+    if (count >= MAX_WATCH_FACES)
+    {
+        return -1;
+    }
+
+    entries[count].factory = factory;
+    entries[count].saved = false;
+
+    count++;
+
+    return count - 1;
+}
+
+bool WatchFaceRegistry::select(uint8_t index)
+{
+    if (index >= count)
+    {
+        return false;
+    }
+
+    if (face && (index == selected))
+    {
+        return true;
+    }
+
+    uint32_t start = UIView::getTimeInMilliseconds();
+
+    int8_t previous = (face) ? selected : -1;
+
+    /* the face shown so far is reduced to its state */
+    if (face)
+    {
+        face->saveState(&entries[selected].state);
+        entries[selected].saved = true;
+
+        delete face;
+    }
+
+    face = create(index);
+    selected = (face) ? index : -1;
+
+    /*  The factory is out of memory or refused the face. The previous one
+        is resumed instead, from the state just saved.
+    */
+    if ((face == NULL) && (previous >= 0))
+    {
+        face = create(previous);
+        selected = (face) ? previous : -1;
+    }
+
+    /* bytes held for faces that are not shown */
+    statistics.inactiveBytes = 0;
+
+    for (uint8_t other = 0; other < count; other++)
+    {
+        if (entries[other].saved)
+        {
+            statistics.inactiveBytes += sizeof(watch_face_state_t);
+        }
+    }
+
+    statistics.switches++;
+    statistics.lastSwitchTime = UIView::getTimeInMilliseconds() - start;
+
+    if (statistics.lastSwitchTime > statistics.worstSwitchTime)
+    {
+        statistics.worstSwitchTime = statistics.lastSwitchTime;
+    }
+
+    return (selected == index);
+}
+
+WatchFaceUI* WatchFaceRegistry::create(uint8_t index)
+{
+    entry_t* entry = &entries[index];
+
+    WatchFaceUI* created = entry->factory(clock, (entry->saved) ? &entry->state : NULL);
+
+    if (created)
+    {
+        created->setWidth(width);
+        created->setHeight(height);
+
+        /* a resumed face is built here, so its first frame is a warm one */
+        created->prepare();
+
+        entry->saved = false;
+    }
+
+    return created;
+}
+
+int8_t WatchFaceRegistry::getSelected() const
+{
+    return selected;
+}
+
+WatchFaceUI* WatchFaceRegistry::getFace()
+{
+    return face;
+}
+
+uint32_t WatchFaceRegistry::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
+                                            int16_t xOffset,
+                                            int16_t yOffset)
+{
+    if (face == NULL)
+    {
+        if (select(0) == false)
+        {
+            return EMPTY_DELAY_MS;
+        }
+    }
+
+    /* the parent may have resized the registry since the face was created */
+    if ((face->getWidth() != width) || (face->getHeight() != height))
+    {
+        face->setWidth(width);
+        face->setHeight(height);
+    }
+
+    return face->fillFrameBuffer(canvas, xOffset, yOffset);
+}
+
+const WatchFaceRegistry::statistics_t& WatchFaceRegistry::getStatistics() const
+{
+    return statistics;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceSnapshot.h"
+
+#include <cstring>
+
+#define SNAPSHOT_HEADER_SIZE 4
+
+uint32_t WatchFaceSnapshot::getSize(uint16_t width, uint16_t height)
+{
+    return SNAPSHOT_HEADER_SIZE + ((width + 7) / 8) * (uint32_t) height;
+}
+
+void WatchFaceSnapshot::capture(SharedPointer<FrameBuffer>& canvas, uint8_t* snapshot)
+{
+    uint16_t width = canvas->getWidth();
+    uint16_t height = canvas->getHeight();
+    uint32_t stride = (width + 7) / 8;
+
+    memset(snapshot, 0, getSize(width, height));
+
+    snapshot[0] = width;
+    snapshot[1] = width >> 8;
+    snapshot[2] = height;
+    snapshot[3] = height >> 8;
+
+    for (uint16_t y = 0; y < height; y++)
+    {
+        uint8_t* row = &snapshot[SNAPSHOT_HEADER_SIZE + y * stride];
+
+        for (uint16_t x = 0; x < width; x++)
+        {
+            if (canvas->getPixel(x, y))
+            {
+                row[x / 8] |= 0x80 >> (x % 8);
+            }
+        }
+    }
+}
+
+bool WatchFaceSnapshot::blit(const uint8_t* snapshot, SharedPointer<FrameBuffer>& canvas)
+{
+    uint16_t width = canvas->getWidth();
+    uint16_t height = canvas->getHeight();
+    uint32_t stride = (width + 7) / 8;
+
+    /* rows of another size would be read past the end of the snapshot */
+    if ((snapshot[0] != (uint8_t) width) || (snapshot[1] != (uint8_t) (width >> 8)) ||
+        (snapshot[2] != (uint8_t) height) || (snapshot[3] != (uint8_t) (height >> 8)))
+    {
+        return false;
+    }
+
+    canvas->drawRectangle(0, width, 0, height, 0);
+
+    for (uint16_t y = 0; y < height; y++)
+    {
+        const uint8_t* row = &snapshot[SNAPSHOT_HEADER_SIZE + y * stride];
+        uint16_t x = 0;
+
+        while (x < width)
+        {
+            /* skip clear bytes whole */
+            if (((x % 8) == 0) && (row[x / 8] == 0))
+            {
+                x += 8;
+                continue;
+            }
+
+            if ((row[x / 8] & (0x80 >> (x % 8))) == 0)
+            {
+                x++;
+                continue;
+            }
+
+            uint16_t start = x;
+
+            while ((x < width) && (row[x / 8] & (0x80 >> (x % 8))))
+            {
+                x++;
+            }
+
+            canvas->drawRectangle(start, x, y, y + 1, 1);
+        }
+    }
+
+    return true;
+}
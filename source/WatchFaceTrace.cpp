@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uif-ui-watch-face-wrd/WatchFaceTrace.h"
+
+#include <cstring>
+
+#define TRACE_MAGIC "WFT1"
+#define TRACE_RECORD_SIZE 26
+
+#define FNV_OFFSET_BASIS 2166136261UL
+#define FNV_PRIME 16777619UL
+
+static void put16(uint8_t* buffer, uint16_t value)
+{
+    buffer[0] = value;
+    buffer[1] = value >> 8;
+}
+
+static void put32(uint8_t* buffer, uint32_t value)
+{
+    put16(&buffer[0], value);
+    put16(&buffer[2], value >> 16);
+}
+
+static uint16_t get16(const uint8_t* buffer)
+{
+    return buffer[0] | (buffer[1] << 8);
+}
+
+static uint32_t get32(const uint8_t* buffer)
+{
+    return get16(&buffer[0]) | ((uint32_t) get16(&buffer[2]) << 16);
+}
+
+uint32_t WatchFaceTrace::hash(SharedPointer<FrameBuffer>& canvas)
+{
+    uint32_t result = FNV_OFFSET_BASIS;
+
+    for (uint16_t y = 0; y < canvas->getHeight(); y++)
+    {
+        uint8_t byte = 0;
+
+        for (uint16_t x = 0; x < canvas->getWidth(); x++)
+        {
+            byte = (byte << 1) | (canvas->getPixel(x, y) ? 1 : 0);
+
+            if (((x % 8) == 7) || (x == canvas->getWidth() - 1))
+            {
+                result = (result ^ byte) * FNV_PRIME;
+                byte = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+/*****************************************************************************/
+/* File                                                                      */
+/*****************************************************************************/
+
+WatchFaceTraceFile::WatchFaceTraceFile(FILE* _file)
+    :   file(_file)
+{
+    fwrite(TRACE_MAGIC, 1, 4, file);
+}
+
+void WatchFaceTraceFile::record(const watch_face_frame_t& frame)
+{
+    uint8_t buffer[TRACE_RECORD_SIZE];
+
+    put32(&buffer[0], frame.timestamp);
+    buffer[4] = frame.time.hour;
+    buffer[5] = frame.time.minute;
+    buffer[6] = frame.time.second;
+    buffer[7] = frame.time.day;
+    buffer[8] = frame.time.date;
+    buffer[9] = frame.modes;
+    put16(&buffer[10], frame.xOffset);
+    put16(&buffer[12], frame.yOffset);
+    put32(&buffer[14], frame.delay);
+    put32(&buffer[18], frame.renderTime);
+    put32(&buffer[22], frame.hash);
+
+    fwrite(buffer, 1, sizeof(buffer), file);
+}
+
+bool WatchFaceTraceFile::readHeader(FILE* file)
+{
+    char magic[4];
+
+    return (fread(magic, 1, sizeof(magic), file) == sizeof(magic)) &&
+           (memcmp(magic, TRACE_MAGIC, sizeof(magic)) == 0);
+}
+
+bool WatchFaceTraceFile::read(FILE* file, watch_face_frame_t* frame)
+{
+    uint8_t buffer[TRACE_RECORD_SIZE];
+
+    if (fread(buffer, 1, sizeof(buffer), file) != sizeof(buffer))
+    {
+        return false;
+    }
+
+    frame->timestamp = get32(&buffer[0]);
+    frame->time.hour = buffer[4];
+    frame->time.minute = buffer[5];
+    frame->time.second = buffer[6];
+    frame->time.day = buffer[7];
+    frame->time.date = buffer[8];
+    frame->modes = buffer[9];
+    frame->xOffset = (int16_t) get16(&buffer[10]);
+    frame->yOffset = (int16_t) get16(&buffer[12]);
+    frame->delay = get32(&buffer[14]);
+    frame->renderTime = get32(&buffer[18]);
+    frame->hash = get32(&buffer[22]);
+
+    return true;
+}
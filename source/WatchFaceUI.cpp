@@ -17,7 +17,40 @@
 
 #include "uif-ui-watch-face-wrd/WatchFaceUI.h"
 
-#include "mbed-time/Calendar.h"
+#include "uif-ui-watch-face-wrd/WatchFaceClock.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "uif-ui-watch-face-wrd/WatchFaceFrameGovernor.h"
+#include "uif-ui-watch-face-wrd/WatchFaceTrace.h"
+#include "uif-ui-watch-face-wrd/WatchFaceSnapshot.h"
+#include "uif-ui-watch-face-wrd/GrayFrameBuffer.h"
+
+#include <cstring>
+
+#if WATCH_FACE_GLYPH_PACK || WATCH_FACE_GLYPH_METRICS
+#include "uif-ui-watch-face-wrd/GlyphPack.h"
+#endif
+
+/* Delay returned while hidden. The face catches up in one go when it is
+   shown again, so there is no reason to wake up more often than this.
+*/
+#define HIDDEN_DELAY_MS 60000
+
+/* Delay before the idle tick that pre-stages the next hour's cells, and the
+   next day's at midnight, during the last minute of the hour.
+*/
+#define PRESTAGE_DELAY_MS 1000
+
+/* Delay after showing the boot snapshot, before building the face. */
+#define BOOT_DELAY_MS 10
+
+/* Delay between ticks while showing seconds. */
+#define SECONDS_DELAY_MS 1000
+
+/* Modes kept in watch_face_state_t::flags. */
+#define STATE_AMBIENT 0x01
+#define STATE_SECONDS 0x02
+#define STATE_ROW_SCROLL 0x04
+#define STATE_RETAINED_CANVAS 0x08
 
 
 #if 0
@@ -29,16 +62,90 @@
 
 #define WATCH_FACE_DEBUG 0
 
-/* Set minimum time between animation frames.
+/* Frame intervals during animations are picked by the frame governor. With
+   easing the roll looks smooth at 5 frames per 250 ms transition, which is
+   what the smooth profile's 50 ms minimum interval gives.
 */
-#define FRAME_LIMIT_MS 40
+#if WATCH_FACE_FRAME_PROFILE == WATCH_FACE_PROFILE_LOW_POWER
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_LOW_POWER
+#else
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_SMOOTH
+#endif
 
-/* Constants to customize watch layout. To use a fixed clock face, comment out
-   top_margin and left_margin in calculatePositionsWithXOffset:andYOffset.
+/* Easing curves as Q15 fractions of the animation, sampled at
+   EASING_STEPS + 1 evenly spaced points in time and linearly interpolated
+   in between. Generated with:
+     linear:   t
+     ease-out: 1 - (1 - t)^3
+     spring:   1 - e^(-6t) * cos(2.5 * pi * t)
 */
-const static int center_space = 3; // space between hour/minutes and day/date
-const static int line_space = 3;   // space between hour/day
-const static int minute_kerning = 2; // space between x0/0x minutes
+#define EASING_STEPS 32
+#define EASING_SHIFT 15
+#define EASING_ONE (1UL << EASING_SHIFT)
+
+static const uint16_t easing_linear[EASING_STEPS + 1] = {
+        0,  1024,  2048,  3072,  4096,  5120,  6144,  7168,  8192,
+     9216, 10240, 11264, 12288, 13312, 14336, 15360, 16384, 17408,
+    18432, 19456, 20480, 21504, 22528, 23552, 24576, 25600, 26624,
+    27648, 28672, 29696, 30720, 31744, 32768
+};
+
+static const uint16_t easing_ease_out[EASING_STEPS + 1] = {
+        0,  2977,  5768,  8379, 10816, 13085, 15192, 17143, 18944,
+    20601, 22120, 23507, 24768, 25909, 26936, 27855, 28672, 29393,
+    30024, 30571, 31040, 31437, 31768, 32039, 32256, 32425, 32552,
+    32643, 32704, 32741, 32760, 32767, 32768
+};
+
+/* overshoots by up to 12% before settling */
+static const uint16_t easing_spring[EASING_STEPS + 1] = {
+        0,  6416, 12906, 18934, 24169, 28445, 31725, 34062, 35566,
+    36379, 36652, 36534, 36155, 35628, 35039, 34456, 33922, 33463,
+    33093, 32814, 32618, 32495, 32432, 32415, 32432, 32469, 32519,
+    32573, 32625, 32672, 32712, 32744, 32768
+};
+
+static const uint16_t* const easing_list[] = {
+    easing_linear,
+    easing_ease_out,
+    easing_spring
+};
+
+/* Constants to customize watch layout, see WatchFaceLayout.h. To use a fixed
+   clock face, comment out top_margin and left_margin in
+   calculatePositionsWithXOffset:andYOffset.
+*/
+const static int center_space = WATCH_FACE_CENTER_SPACE;
+const static int line_space = WATCH_FACE_LINE_SPACE;
+const static int minute_kerning = WATCH_FACE_MINUTE_KERNING;
+
+#if WATCH_FACE_GLYPH_METRICS
+static const watch_face_metrics_t face_metrics = {
+    GlyphMetrics_Hours,
+    GlyphMetrics_Minutes,
+    GlyphMetrics_Dayndate
+};
+
+#define FACE_METRICS &face_metrics
+#else
+#define FACE_METRICS NULL
+#endif
+
+#if WATCH_FACE_GLYPH_PACK
+static const watch_face_fonts_t face_fonts = {
+    &GlyphPack_Hours,
+    &GlyphPack_Minutes,
+    &GlyphPack_Dayndate,
+    &GlyphPack_Seconds
+};
+#else
+static const watch_face_fonts_t face_fonts = {
+    &Font_Hours,
+    &Font_Minutes,
+    &Font_Dayndate,
+    &Font_Dayndate
+};
+#endif
 
 static const char * day_list[] = {
     "SUN",
@@ -50,25 +157,293 @@ static const char * day_list[] = {
     "SAT"
   };
 
+typedef enum {
+    FONT_HOURS,
+    FONT_MINUTES,
+    FONT_DAYNDATE,
+    FONT_SECONDS
+} cell_font_t;
+
+/*  Create an inverted cell showing the given text in one of the face's
+    fonts. With glyph packs enabled the bitmap is read straight from flash,
+    and blended while the face's gray flag is set.
+    Otherwise the text is pre-fetched, which converts the c-string into a
+    cached CompBuf and allows the c-string to be freed when the stack
+    unrolls.
+*/
+static UIView* createCell(const char* text, cell_font_t font, const watch_face_fonts_t* fonts,
+                          const bool* gray)
+{
+#if WATCH_FACE_GLYPH_PACK
+    const glyph_pack_t* glyphs = NULL;
+#else
+    const FontData* glyphs = NULL;
+#endif
+
+    switch (font)
+    {
+        case FONT_HOURS:
+                glyphs = fonts->hours;
+                break;
+        case FONT_MINUTES:
+                glyphs = fonts->minutes;
+                break;
+        case FONT_SECONDS:
+                glyphs = fonts->seconds;
+                break;
+        case FONT_DAYNDATE:
+        default:
+                glyphs = fonts->dayndate;
+                break;
+    }
+
+#if WATCH_FACE_GLYPH_PACK
+    GlyphPackView* cell = new GlyphPackView(glyphs, text);
+
+    cell->setGrayCanvas(gray);
+#else
+    (void) gray;
+
+    UITextView* cell = new UITextView(text, glyphs);
+
+    cell->prefetch(0, 0);
+#endif
+
+    /*  Invert cells to draw white on black.
+    */
+    cell->setInverse(true);
+
+    return cell;
+}
+
+/*  Give a cell new text. Glyph pack cells are re-pointed in place without
+    allocating. UITextView cannot change its text, so text cells are deleted
+    and created and pre-fetched again; callers skip cells whose text stays.
+*/
+static void replaceCell(UIView** cell, const char* text, cell_font_t font,
+                        const watch_face_fonts_t* fonts)
+{
+#if WATCH_FACE_GLYPH_PACK
+    (void) font;
+    (void) fonts;
+
+    static_cast<GlyphPackView*>(*cell)->setLabel(text);
+#else
+    delete *cell;
+    *cell = createCell(text, font, fonts, NULL);
+#endif
+}
+
 WatchFaceUI::WatchFaceUI()
     :   UIView(),
-        transitionTimeInMilliSeconds(250),
-        animateMinute(false)
+        metrics(FACE_METRICS),
+        fonts(&face_fonts),
+        clock(new WatchFaceCalendarClock()),
+        governor(FRAME_PROFILE)
+{
+    init(NULL, NULL);
+}
+
+WatchFaceUI::WatchFaceUI(SharedPointer<WatchFaceClock> _clock)
+    :   UIView(),
+        metrics(FACE_METRICS),
+        fonts(&face_fonts),
+        clock(_clock),
+        governor(FRAME_PROFILE)
+{
+    init(NULL, NULL);
+}
+
+WatchFaceUI::WatchFaceUI(SharedPointer<WatchFaceClock> _clock, const watch_face_state_t& state)
+    :   UIView(),
+        metrics(FACE_METRICS),
+        fonts(&face_fonts),
+        clock(_clock),
+        governor(FRAME_PROFILE)
+{
+    init(&state, NULL);
+}
+
+WatchFaceUI::WatchFaceUI(SharedPointer<WatchFaceClock> _clock, const watch_face_state_t* state,
+                         const uint8_t* snapshot)
+    :   UIView(),
+        metrics(FACE_METRICS),
+        fonts(&face_fonts),
+        clock(_clock),
+        governor(FRAME_PROFILE)
+{
+    init(state, snapshot);
+}
+
+WatchFaceUI::WatchFaceUI(SharedPointer<WatchFaceClock> _clock, const watch_face_state_t* state,
+                         const uint8_t* snapshot, const watch_face_metrics_t* _metrics,
+                         const watch_face_fonts_t* _fonts)
+    :   UIView(),
+        metrics(_metrics),
+        fonts(_fonts),
+        clock(_clock),
+        governor(FRAME_PROFILE)
+{
+    init(state, snapshot);
+}
+
+WatchFaceUI::~WatchFaceUI()
+{
+    /*  The next_ cells only differ from the current ones while an animation
+        is in progress.
+    */
+    if (next_hour_cell != hour_cell)
+    {
+        delete next_hour_cell;
+    }
+
+    if (next_minute_x0_cell != minute_x0_cell)
+    {
+        delete next_minute_x0_cell;
+    }
+
+    if (next_minute_0x_cell != minute_0x_cell)
+    {
+        delete next_minute_0x_cell;
+    }
+
+    delete hour_cell;
+    delete minute_x0_cell;
+    delete minute_0x_cell;
+    delete day_cell;
+    delete date_cell;
+
+    delete staged_hour_cell;
+    delete staged_day_cell;
+    delete staged_date_cell;
+
+    releaseRetiredCells();
+
+    if (seconds)
+    {
+        for (uint8_t digit = 0; digit < 10; digit++)
+        {
+            delete second_cells[digit];
+        }
+    }
+}
+
+void WatchFaceUI::init(const watch_face_state_t* state, const uint8_t* snapshot)
 {
     /* Default size unless overwritten by parent. */
-    UIView::width = 128;
-    UIView::height = 128;
+    UIView::width = WATCH_FACE_PANEL_WIDTH;
+    UIView::height = WATCH_FACE_PANEL_HEIGHT;
+
+    /* Defaults, shared by all constructors. */
+    recorder = NULL;
+    animationCpuTime = 0;
+    animationOverrun = 0;
+    transitionTimeInMilliSeconds = 250;
+    easing = EASING_EASE_OUT;
+    ambientForced = false;
+    ambientStartHour = 0;
+    ambientEndHour = 0;
+    ambientInterval = 1;
+    visible = true;
+    stale = false;
+    staged_hour_cell = NULL;
+    staged_day_cell = NULL;
+    staged_date_cell = NULL;
+    retired_cells = 0;
+    animateMinute = false;
+    rowScroll = false;
+    scrollCanvas = NULL;
+    grayCanvas = NULL;
+    grayFrame = false;
+    scrollOffset = -1;
+    scrollLeft = 0;
+    complicationCount = 0;
+    complicationsDrawn = 0;
+    retainedCanvas = false;
+    canvasDrawn = false;
+    drawnWidth = 0;
+    drawnHeight = 0;
+    cellsPending = (state != NULL);
+    pendingSeconds = (state != NULL) && (state->flags & STATE_SECONDS);
+    bootSnapshot = (state) ? snapshot : NULL;
+    seconds = false;
+    second_width = 0;
+    second_drawn = -1;
+    seconds_damaged = false;
+
+    memset(&statistics, 0, sizeof(statistics_t));
+
+    /* no date is 0, so the first frame lays out the face */
+    memset(&layout, 0, sizeof(WatchFaceLayout::layout_t));
+    memset(&next_layout, 0, sizeof(WatchFaceLayout::layout_t));
+
+    if (state)
+    {
+        /*  Resume where the face left off. The first frame catches up with
+            the clock without animating.
+        */
+        hour_int = state->time.hour;
+        minute_int = state->time.minute;
+        second_int = state->time.second;
+        date_int = state->time.date;
+        day_int = state->time.day;
+
+        UIView::width = state->width;
+        UIView::height = state->height;
+
+        easing = (easing_t) state->easing;
+        transitionTimeInMilliSeconds = (state->transitionTime > 0) ? state->transitionTime : 250;
+        ambientForced = (state->flags & STATE_AMBIENT) != 0;
+        ambientStartHour = state->ambientStartHour;
+        ambientEndHour = state->ambientEndHour;
+        ambientInterval = state->ambientInterval;
+        rowScroll = (state->flags & STATE_ROW_SCROLL) != 0;
+        retainedCanvas = (state->flags & STATE_RETAINED_CANVAS) != 0;
+
+        /* the layout matches the time, so it is not computed again */
+        layout = state->layout;
+        next_layout = state->layout;
+
+        stale = true;
+    }
+    else
+    {
+        /* Get initial time to display. */
+        clock->getTime(&hour_int, &minute_int, &second_int);
+        date_int = clock->getDate();
+        day_int = clock->getDay();
+    }
 
-    /* Get initial time to display. */
-    hour_int = Calendar::getHour();
-    minute_int = Calendar::getMinute();
-    second_int = Calendar::getSecond();
-    date_int = Calendar::getDate();
-    day_int = Calendar::getDay();
+    /*  Q16 easing steps per millisecond. This is the only divide needed to
+        map animation progress onto the easing curve.
+    */
+    progressScale = (EASING_STEPS << 16) / transitionTimeInMilliSeconds;
 
     printf("WatchFaceUI: %d %d %d %d %d\r\n",
             hour_int, minute_int, second_int, date_int, day_int);
 
+    /*  A resumed face builds its cells on the first frame, and a cold
+        start on the frame after the snapshot, see fillFrameBuffer.
+    */
+    if (cellsPending)
+    {
+        hour_cell = NULL;
+        next_hour_cell = NULL;
+        minute_x0_cell = NULL;
+        minute_0x_cell = NULL;
+        next_minute_x0_cell = NULL;
+        next_minute_0x_cell = NULL;
+        day_cell = NULL;
+        date_cell = NULL;
+
+        return;
+    }
+
+    createCells();
+}
+
+void WatchFaceUI::createCells()
+{
     /* convert int to c-string */
     char hour_array[3];
     hour_array[0] = (hour_int / 10) + 48;
@@ -89,65 +464,454 @@ WatchFaceUI::WatchFaceUI()
     date_array[2] = '\0';
 
     /* allocate cells */
-    hour_cell = new UITextView(hour_array, &Font_Hours);
+    hour_cell = createCell(hour_array, FONT_HOURS, fonts, &grayFrame);
     next_hour_cell = hour_cell;
 
-    minute_x0_cell = new UITextView(minute_x0_array, &Font_Minutes);
-    minute_0x_cell = new UITextView(minute_0x_array, &Font_Minutes);
+    minute_x0_cell = createCell(minute_x0_array, FONT_MINUTES, fonts, &grayFrame);
+    minute_0x_cell = createCell(minute_0x_array, FONT_MINUTES, fonts, &grayFrame);
     next_minute_x0_cell = minute_x0_cell;
     next_minute_0x_cell = minute_0x_cell;
 
-    day_cell = new UITextView(day_list[day_int], &Font_Dayndate);
-    date_cell = new UITextView(date_array, &Font_Dayndate);
+    day_cell = createCell(day_list[day_int], FONT_DAYNDATE, fonts, &grayFrame);
+    date_cell = createCell(date_array, FONT_DAYNDATE, fonts, &grayFrame);
+}
 
-    /*  Pre-fetch. This converts the c-string into a cached CompBuf and allows
-        the c-string to be freed when the stack unrolls.
-    */
-    hour_cell->prefetch(0, 0);
-    minute_x0_cell->prefetch(0, 0);
-    minute_0x_cell->prefetch(0, 0);
-    day_cell->prefetch(0, 0);
-    date_cell->prefetch(0, 0);
+void WatchFaceUI::setAnimationEasing(easing_t _easing)
+{
+    easing = _easing;
+}
 
-    /*  Invert cells to draw white on black.
+void WatchFaceUI::setTransitionTime(uint16_t milliseconds)
+{
+    /* a roll in progress is not rescaled, it jumps to its end */
+    if (animateMinute)
+    {
+        completeMinuteAnimation();
+
+        scrollOffset = -1;
+        canvasDrawn = false;
+    }
+
+    transitionTimeInMilliSeconds = (milliseconds > 0) ? milliseconds : 1;
+    progressScale = (EASING_STEPS << 16) / transitionTimeInMilliSeconds;
+}
+
+void WatchFaceUI::setAmbient(bool ambient)
+{
+    ambientForced = ambient;
+
+    /* seconds are shown or hidden by a full frame */
+    canvasDrawn = false;
+}
+
+void WatchFaceUI::setAmbientSchedule(uint8_t startHour, uint8_t endHour, uint8_t intervalMinutes)
+{
+    ambientStartHour = startHour;
+    ambientEndHour = endHour;
+    ambientInterval = (intervalMinutes > 0) ? intervalMinutes : 1;
+
+    canvasDrawn = false;
+}
+
+void WatchFaceUI::setVisible(bool _visible)
+{
+    if (visible && !_visible)
+    {
+        /* nobody will see the rest of the animation */
+        if (animateMinute)
+        {
+            completeMinuteAnimation();
+        }
+
+        stale = true;
+        scrollOffset = -1;
+        canvasDrawn = false;
+    }
+
+    visible = _visible;
+}
+
+void WatchFaceUI::syncCells(const watch_face_time_t& now)
+{
+    if (animateMinute)
+    {
+        completeMinuteAnimation();
+    }
+
+    if ((now.minute != minute_int) || (now.hour != hour_int))
+    {
+        char minute_x0_array[2];
+        minute_x0_array[0] = (now.minute / 10) + 48;
+        minute_x0_array[1] = '\0';
+
+        char minute_0x_array[2];
+        minute_0x_array[0] = (now.minute % 10) + 48;
+        minute_0x_array[1] = '\0';
+
+        char hour_array[3];
+        hour_array[0] = (now.hour / 10) + 48;
+        hour_array[1] = (now.hour % 10) + 48;
+        hour_array[2] = '\0';
+
+        /* only the digits that changed, text cells are recreated */
+        if ((now.minute / 10) != (minute_int / 10))
+        {
+            replaceCell(&minute_x0_cell, minute_x0_array, FONT_MINUTES, fonts);
+        }
+
+        if ((now.minute % 10) != (minute_int % 10))
+        {
+            replaceCell(&minute_0x_cell, minute_0x_array, FONT_MINUTES, fonts);
+        }
+
+        if (now.hour != hour_int)
+        {
+            replaceCell(&hour_cell, hour_array, FONT_HOURS, fonts);
+        }
+
+        next_minute_x0_cell = minute_x0_cell;
+        next_minute_0x_cell = minute_0x_cell;
+        next_hour_cell = hour_cell;
+
+        minute_int = now.minute;
+        hour_int = now.hour;
+    }
+
+    /* day and date are picked up by the regular update in renderFrame */
+}
+
+void WatchFaceUI::setRowScroll(bool enable)
+{
+    rowScroll = enable;
+    scrollOffset = -1;
+}
+
+void WatchFaceUI::setScrollCanvas(ScrollFrameBuffer* canvas)
+{
+    scrollCanvas = canvas;
+    scrollOffset = -1;
+}
+
+void WatchFaceUI::setGrayCanvas(GrayFrameBuffer* canvas)
+{
+    grayCanvas = canvas;
+    canvasDrawn = false;
+}
+
+void WatchFaceUI::saveState(watch_face_state_t* state) const
+{
+    state->time.hour = hour_int;
+    state->time.minute = minute_int;
+    state->time.second = second_int;
+    state->time.day = day_int;
+    state->time.date = date_int;
+
+    state->flags = (ambientForced ? STATE_AMBIENT : 0) |
+                   (seconds ? STATE_SECONDS : 0) |
+                   (pendingSeconds ? STATE_SECONDS : 0) |
+                   (rowScroll ? STATE_ROW_SCROLL : 0) |
+                   (retainedCanvas ? STATE_RETAINED_CANVAS : 0);
+
+    state->easing = easing;
+    state->transitionTime = transitionTimeInMilliSeconds;
+    state->ambientStartHour = ambientStartHour;
+    state->ambientEndHour = ambientEndHour;
+    state->ambientInterval = ambientInterval;
+    state->width = width;
+    state->height = height;
+
+    /* the layout being rolled in belongs to hour_int and minute_int */
+    state->layout = next_layout;
+}
+
+void WatchFaceUI::prepare()
+{
+    if (cellsPending)
+    {
+        bootSnapshot = NULL;
+
+        buildCells();
+    }
+}
+
+void WatchFaceUI::buildCells()
+{
+    /*  The cells are created for the current time rather than the one in
+        the state, so the next frame has nothing left to catch up with.
     */
-    hour_cell->setInverse(true);
-    minute_x0_cell->setInverse(true);
-    minute_0x_cell->setInverse(true);
-    day_cell->setInverse(true);
-    date_cell->setInverse(true);
+    clock->getTime(&hour_int, &minute_int, &second_int);
+    date_int = clock->getDate();
+    day_int = clock->getDay();
+
+    createCells();
+
+    if (pendingSeconds)
+    {
+        setSeconds(true);
+    }
+
+    cellsPending = false;
 }
 
-void WatchFaceUI::calculateCenter(positions_t* positions,
-                                  uint32_t progress,
-                                  uint32_t period)
+void WatchFaceUI::setSeconds(bool enable)
 {
-    /* center clock on screen. */
+    /* overrides the mode of a state not applied yet */
+    pendingSeconds = false;
 
-    if (progress < period)
+    if (enable == seconds)
     {
-        uint32_t left_now = (width - hour_cell->getWidth()
-                                   - minute_x0_cell->getWidth()
-                                   - minute_0x_cell->getWidth()
-                                   - center_space) / 2;
+        return;
+    }
 
-        uint32_t left_next = (width - next_hour_cell->getWidth()
-                                    - next_minute_x0_cell->getWidth()
-                                    - next_minute_0x_cell->getWidth()
-                                    - center_space) / 2;
+    if (enable)
+    {
+        /* the digits are drawn from these cells on every tick */
+        second_width = 0;
 
-        if (left_next < left_now)
+        for (uint8_t digit = 0; digit < 10; digit++)
         {
-            uint32_t diff = left_now - left_next;
+            char digit_array[2];
+            digit_array[0] = digit + 48;
+            digit_array[1] = '\0';
+
+            second_cells[digit] = createCell(digit_array, FONT_SECONDS, fonts, &grayFrame);
+            second_cells[digit]->setHorizontalAlignment(UIView::ALIGN_LEFT);
+            second_cells[digit]->setVerticalAlignment(UIView::VALIGN_TOP);
 
-            positions->left_margin = left_now - ((diff * progress) / period);
+            if (second_cells[digit]->getWidth() > second_width)
+            {
+                second_width = second_cells[digit]->getWidth();
+            }
         }
-        else
+    }
+    else
+    {
+        for (uint8_t digit = 0; digit < 10; digit++)
+        {
+            delete second_cells[digit];
+        }
+    }
+
+    seconds = enable;
+    second_drawn = -1;
+    canvasDrawn = false;
+}
+
+bool WatchFaceUI::getSecondsDamage(watch_face_rect_t* region) const
+{
+    if (seconds_damaged)
+    {
+        *region = seconds_rect;
+    }
+
+    return seconds_damaged;
+}
+
+bool WatchFaceUI::addComplication(WatchFaceComplication* complication,
+                                  const watch_face_rect_t& region,
+                                  uint32_t intervalMilliseconds)
+{
+    if (complicationCount >= MAX_COMPLICATIONS)
+    {
+        return false;
+    }
+
+    complication_slot_t* slot = &complications[complicationCount];
+
+    /* refreshed and drawn on the next frame */
+    slot->complication = complication;
+    slot->region = region;
+    slot->interval = intervalMilliseconds;
+    slot->deadline = clock->getTimeInMilliseconds();
+    slot->changed = true;
+
+    complicationCount++;
+
+    return true;
+}
+
+void WatchFaceUI::removeComplication(WatchFaceComplication* complication)
+{
+    for (uint8_t index = 0; index < complicationCount; index++)
+    {
+        if (complications[index].complication == complication)
+        {
+            complicationCount--;
+
+            for (uint8_t next = index; next < complicationCount; next++)
+            {
+                complications[next] = complications[next + 1];
+            }
+
+            /* the region has to be cleared by a full frame */
+            canvasDrawn = false;
+
+            return;
+        }
+    }
+}
+
+void WatchFaceUI::setRetainedCanvas(bool retained)
+{
+    retainedCanvas = retained;
+    canvasDrawn = false;
+}
+
+uint8_t WatchFaceUI::getComplicationDamage(watch_face_rect_t* regions) const
+{
+    uint8_t count = 0;
+
+    for (uint8_t index = 0; index < complicationCount; index++)
+    {
+        if (complicationsDrawn & (1 << index))
+        {
+            regions[count] = complications[index].region;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+bool WatchFaceUI::isAmbient(uint8_t hour) const
+{
+    if (ambientForced)
+    {
+        return true;
+    }
+
+    /* schedule may wrap around midnight, e.g., 22-6 */
+    if (ambientStartHour < ambientEndHour)
+    {
+        return (hour >= ambientStartHour) && (hour < ambientEndHour);
+    }
+    else if (ambientStartHour > ambientEndHour)
+    {
+        return (hour >= ambientStartHour) || (hour < ambientEndHour);
+    }
+
+    return false;
+}
+
+const WatchFaceUI::statistics_t& WatchFaceUI::getStatistics() const
+{
+    return statistics;
+}
+
+const WatchFaceFrameGovernor::statistics_t& WatchFaceUI::getFrameStatistics() const
+{
+    return governor.getStatistics();
+}
+
+uint32_t WatchFaceUI::easeProgress(uint32_t progress)
+{
+    if (progress >= transitionTimeInMilliSeconds)
+    {
+        return EASING_ONE;
+    }
+
+    const uint16_t* curve = easing_list[easing];
+
+    uint32_t position = progress * progressScale;
+    uint32_t step = position >> 16;
+    int32_t remainder = position & 0xFFFF;
+
+    return curve[step] + (((curve[step + 1] - curve[step]) * remainder) >> 16);
+}
+
+void WatchFaceUI::calculateLayout(const watch_face_time_t& time, WatchFaceLayout::layout_t* _layout)
+{
+    WatchFaceLayout::calculate(*metrics, time, width, height, _layout);
+}
+
+void WatchFaceUI::updateLayout()
+{
+    if (metrics == NULL)
+    {
+        return;
+    }
+
+    watch_face_time_t time = { hour_int, minute_int, 0, day_int, date_int };
+
+    if ((next_layout.width != width) || (next_layout.height != height) ||
+        (next_layout.time.hour != hour_int) || (next_layout.time.minute != minute_int) ||
+        (next_layout.time.day != day_int) || (next_layout.time.date != date_int))
+    {
+        calculateLayout(time, &next_layout);
+    }
+
+    if (animateMinute == false)
+    {
+        layout = next_layout;
+    }
+    else if ((layout.width != width) || (layout.height != height))
+    {
+        time = layout.time;
+
+        calculateLayout(time, &layout);
+    }
+}
+
+uint8_t WatchFaceUI::getDamage(watch_face_rect_t* regions) const
+{
+    if (metrics)
+    {
+        return WatchFaceLayout::damage(layout, next_layout, regions);
+    }
+
+    if (animateMinute == false)
+    {
+        return 0;
+    }
+
+    regions[0].x = 0;
+    regions[0].y = 0;
+    regions[0].width = width;
+    regions[0].height = height;
+
+    return 1;
+}
+
+void WatchFaceUI::calculateCenter(positions_t* positions, uint32_t fraction)
+{
+    /* center clock on screen. */
+
+    if (metrics)
+    {
+        /* the layouts were computed from the glyph metrics ahead of drawing */
+        if (fraction < EASING_ONE)
         {
-            uint32_t diff = left_next - left_now;
+            int32_t left_now = layout.hour.x;
+            int32_t left_next = next_layout.hour.x;
 
-            positions->left_margin = left_now + ((diff * progress) / period);
+            positions->left_margin = left_now + (((left_next - left_now) * (int32_t) fraction)
+                                                 >> EASING_SHIFT);
         }
+        else
+        {
+            positions->left_margin = next_layout.hour.x;
+        }
+
+        positions->top_margin = layout.minute_x0.y;
+
+        return;
+    }
+
+    if (fraction < EASING_ONE)
+    {
+        int32_t left_now = (width - hour_cell->getWidth()
+                                  - minute_x0_cell->getWidth()
+                                  - minute_0x_cell->getWidth()
+                                  - center_space) / 2;
+
+        int32_t left_next = (width - next_hour_cell->getWidth()
+                                   - next_minute_x0_cell->getWidth()
+                                   - next_minute_0x_cell->getWidth()
+                                   - center_space) / 2;
+
+        /* slide from the current to the next margin along the easing curve */
+        positions->left_margin = left_now + (((left_next - left_now) * (int32_t) fraction)
+                                             >> EASING_SHIFT);
     }
     else
     {
@@ -160,6 +924,134 @@ void WatchFaceUI::calculateCenter(positions_t* positions,
     positions->top_margin = (height - minute_x0_cell->getHeight()) / 2;
 }
 
+void WatchFaceUI::completeMinuteAnimation()
+{
+    /*  Cleanup by replacing the old objects with the new ones. The old ones
+        are freed on the next idle frame.
+    */
+    animateMinute = false;
+
+    if (hour_cell != next_hour_cell)
+    {
+        retireCell(hour_cell);
+
+        hour_cell = next_hour_cell;
+    }
+
+    if (minute_x0_cell != next_minute_x0_cell)
+    {
+        retireCell(minute_x0_cell);
+
+        minute_x0_cell = next_minute_x0_cell;
+    }
+
+    if (minute_0x_cell != next_minute_0x_cell)
+    {
+        retireCell(minute_0x_cell);
+
+        minute_0x_cell = next_minute_0x_cell;
+    }
+}
+
+void WatchFaceUI::retireCell(UIView* cell)
+{
+    if (retired_cells < MAX_RETIRED_CELLS)
+    {
+        retired[retired_cells++] = cell;
+    }
+    else
+    {
+        delete cell;
+    }
+}
+
+void WatchFaceUI::releaseRetiredCells()
+{
+    while (retired_cells > 0)
+    {
+        delete retired[--retired_cells];
+    }
+}
+
+UIView* WatchFaceUI::takeStagedCell(UIView** staged, uint8_t staged_int, uint8_t value)
+{
+    UIView* cell = *staged;
+
+    *staged = NULL;
+
+    /* the clock was set since staging, the cell is of no use */
+    if (cell && (staged_int != value))
+    {
+        retireCell(cell);
+
+        cell = NULL;
+    }
+
+    return cell;
+}
+
+bool WatchFaceUI::needsPrestage() const
+{
+    if ((minute_int != 59) || animateMinute)
+    {
+        return false;
+    }
+
+    if (staged_hour_cell == NULL)
+    {
+        return true;
+    }
+
+    return (hour_int == 23) && ((staged_day_cell == NULL) || (staged_date_cell == NULL));
+}
+
+void WatchFaceUI::prestageCells()
+{
+    /*  During the last minute of the hour, create the cells the roll over
+        will need so the roll over frame costs no more than a normal minute
+        roll. At midnight this also covers the day and date.
+    */
+    if (staged_hour_cell == NULL)
+    {
+        staged_hour_int = (hour_int + 1) % 24;
+
+        char hour_array[3];
+        hour_array[0] = (staged_hour_int / 10) + 48;
+        hour_array[1] = (staged_hour_int % 10) + 48;
+        hour_array[2] = '\0';
+
+        staged_hour_cell = createCell(hour_array, FONT_HOURS, fonts, &grayFrame);
+        staged_hour_cell->setHorizontalAlignment(UIView::ALIGN_RIGHT);
+        staged_hour_cell->setVerticalAlignment(UIView::VALIGN_TOP);
+    }
+
+    if (hour_int == 23)
+    {
+        if (staged_day_cell == NULL)
+        {
+            staged_day_int = (day_int + 1) % 7;
+
+            staged_day_cell = createCell(day_list[staged_day_int], FONT_DAYNDATE, fonts, &grayFrame);
+            staged_day_cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
+            staged_day_cell->setVerticalAlignment(UIView::VALIGN_TOP);
+        }
+
+        if (staged_date_cell == NULL)
+        {
+            staged_date_int = (date_int >= clock->getDaysInMonth()) ? 1 : date_int + 1;
+
+            char date_array[3];
+            date_array[0] = (staged_date_int / 10) + 48;
+            date_array[1] = (staged_date_int % 10) + 48;
+            date_array[2] = '\0';
+
+            staged_date_cell = createCell(date_array, FONT_DAYNDATE, fonts, &grayFrame);
+            staged_date_cell->setHorizontalAlignment(UIView::ALIGN_RIGHT);
+            staged_date_cell->setVerticalAlignment(UIView::VALIGN_TOP);
+        }
+    }
+}
+
 void WatchFaceUI::calculatePositions(positions_t* positions, int xOffset, int yOffset)
 {
     /*  Calculate positions and offsets for all UIView compoinents.
@@ -169,6 +1061,13 @@ void WatchFaceUI::calculatePositions(positions_t* positions, int xOffset, int yO
     int xBase = (xOffset < 0) ? xOffset : 0;
     int yBase = (yOffset < 0) ? yOffset : 0;
 
+    if (metrics)
+    {
+        calculatePositionsFromLayout(positions, xBase, yBase);
+
+        return;
+    }
+
     /* most significant part of the minute */
     positions->minute_x0_x = xBase + positions->left_margin
                                    + hour_cell->getWidth()
@@ -219,6 +1118,41 @@ void WatchFaceUI::calculatePositions(positions_t* positions, int xOffset, int yO
 }
 
 
+void WatchFaceUI::calculatePositionsFromLayout(positions_t* positions, int xBase, int yBase)
+{
+    /*  Cells keep their place relative to the hour cell in the layout on
+        screen, only the margin slides during the animation. The date
+        follows the day shown, which changes at once.
+    */
+    int left = xBase + positions->left_margin;
+
+    positions->hour_x = left;
+    positions->hour_y = yBase + layout.hour.y;
+
+    positions->minute_x0_x = left + (layout.minute_x0.x - layout.hour.x);
+    positions->minute_x0_y = yBase + layout.minute_x0.y;
+
+    positions->minute_0x_x = left + (layout.minute_0x.x - layout.hour.x);
+    positions->minute_0x_y = yBase + layout.minute_0x.y;
+
+    positions->day_x = left;
+    positions->day_y = yBase + layout.day.y;
+
+    positions->date_x = left + (next_layout.date.x - next_layout.day.x);
+    positions->date_y = positions->day_y;
+
+    positions->hour_x_offset = (positions->hour_x < 0) ? positions->hour_x : 0;
+    positions->hour_y_offset = (positions->hour_y < 0) ? positions->hour_y : 0;
+    positions->minute_x0_x_offset = (positions->minute_x0_x < 0) ? positions->minute_x0_x : 0;
+    positions->minute_x0_y_offset = (positions->minute_x0_y < 0) ? positions->minute_x0_y : 0;
+    positions->minute_0x_x_offset = (positions->minute_0x_x < 0) ? positions->minute_0x_x : 0;
+    positions->minute_0x_y_offset = (positions->minute_0x_y < 0) ? positions->minute_0x_y : 0;
+    positions->day_x_offset = (positions->day_x < 0) ? positions->day_x : 0;
+    positions->day_y_offset = (positions->day_y < 0) ? positions->day_y : 0;
+    positions->date_x_offset = (positions->date_x < 0) ? positions->date_x : 0;
+    positions->date_y_offset = (positions->date_y < 0) ? positions->date_y : 0;
+}
+
 /*
  * :
  * :                         top_margin
@@ -248,29 +1182,247 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
                                       int16_t xOffset,
                                       int16_t yOffset)
 {
+    /*  While hidden nothing is read, allocated or drawn. The state is
+        brought up to date once the face is visible again.
+    */
+    if (visible == false)
+    {
+        statistics.hiddenFrames++;
+
+        if (recorder)
+        {
+            recordShownFrame(canvas, xOffset, yOffset, HIDDEN_DELAY_MS, 0);
+        }
+
+        return HIDDEN_DELAY_MS;
+    }
+
+    /*  Resume and cold start. A cold start shows the snapshot first, the
+        face is built on the next frame. A snapshot of another panel size
+        is not shown and the face is built right away.
+    */
+    if (cellsPending)
+    {
+        const uint8_t* snapshot = bootSnapshot;
+
+        bootSnapshot = NULL;
+
+        if (snapshot && WatchFaceSnapshot::blit(snapshot, canvas))
+        {
+            if (recorder)
+            {
+                recordShownFrame(canvas, xOffset, yOffset, BOOT_DELAY_MS,
+                                 WATCH_FACE_FRAME_BOOT);
+            }
+
+            return BOOT_DELAY_MS;
+        }
+
+        buildCells();
+    }
+
+    uint32_t start = clock->getTimeInMilliseconds();
+
+    governor.frameStarted(start);
+
+    /* the cells blend gray glyphs only into the canvas named for it */
+    grayFrame = (grayCanvas != NULL) && (canvas.get() == grayCanvas);
+
     /*  Get time, both for displaying but also for keeping track of call
         intervals.
     */
-    uint8_t new_hour = 0;
-    uint8_t new_minute = 0;
-    uint8_t new_second = 0;
+    watch_face_time_t now;
 
 #if WATCH_FACE_DEBUG
-    Calendar::getHour(&new_second, &new_hour, &new_minute);
+    clock->getTime(&now.second, &now.hour, &now.minute);
 #else
-    Calendar::getHour(&new_hour, &new_minute, &new_second);
+    clock->getTime(&now.hour, &now.minute, &now.second);
 #endif
 
-//    printf("calendar: %d %d %d\n\r", new_hour, new_minute, new_second);
+//    printf("calendar: %d %d %d\n\r", now.hour, now.minute, now.second);
+
+    now.date = clock->getDate();
+    now.day = clock->getDay();
+
+    /* refresh the complications that are due before drawing */
+    complicationsDrawn = 0;
+    seconds_damaged = false;
+    updateComplications(start, now);
+
+    renderFrame(canvas, xOffset, yOffset, now, start);
+
+    /*  The clock is read once more, at the end of the frame, for the frame
+        cost and the governor. A replay that moves its clock from the
+        recorded timestamp to timestamp + renderTime on that read sees the
+        frame exactly as recorded.
+    */
+    uint32_t end = clock->getTimeInMilliseconds();
+    uint32_t renderTime = end - start;
+
+    uint32_t delay = (animateMinute) ? animationDelay(end)
+                                     : idleDelay(now, isAmbient(now.hour));
+
+    /* wake up in time for the next complication refresh */
+    delay = complicationDelay(start, delay);
+
+    statistics.frames++;
+
+    if (renderTime > statistics.worstFrameTime)
+    {
+        statistics.worstFrameTime = renderTime;
+    }
+
+    /*  Frame-budget watchdog. Charge the frame to the running animation, the
+        next frame snaps to the final state once the limits are crossed.
+    */
+    if (animateMinute)
+    {
+        const WatchFaceFrameGovernor::watchdog_t& watchdog = governor.getWatchdog();
+
+        animationCpuTime += renderTime;
+
+        if (renderTime > watchdog.frameBudget)
+        {
+            animationOverrun += renderTime - watchdog.frameBudget;
+        }
+    }
+
+    if (recorder)
+    {
+        recordFrame(canvas, xOffset, yOffset, start, now, delay, renderTime, 0);
+    }
+
+    return delay;
+}
+
+void WatchFaceUI::setTraceRecorder(WatchFaceTraceRecorder* _recorder)
+{
+    recorder = _recorder;
+}
+
+void WatchFaceUI::recordFrame(SharedPointer<FrameBuffer>& canvas,
+                              int16_t xOffset,
+                              int16_t yOffset,
+                              uint32_t start,
+                              const watch_face_time_t& now,
+                              uint32_t delay,
+                              uint32_t renderTime,
+                              uint8_t modes)
+{
+    watch_face_frame_t frame;
+
+    frame.timestamp = start;
+    frame.time = now;
+    frame.xOffset = xOffset;
+    frame.yOffset = yOffset;
+    frame.delay = delay;
+    frame.renderTime = renderTime;
+
+    /* the modes a replay has to set on its face before this frame */
+    frame.modes = modes |
+                  (ambientForced ? WATCH_FACE_FRAME_AMBIENT : 0) |
+                  ((seconds || pendingSeconds) ? WATCH_FACE_FRAME_SECONDS : 0) |
+                  (rowScroll ? WATCH_FACE_FRAME_ROW_SCROLL : 0) |
+                  (retainedCanvas ? WATCH_FACE_FRAME_RETAINED_CANVAS : 0) |
+                  (visible ? 0 : WATCH_FACE_FRAME_HIDDEN);
+
+    /* only computed here since it reads back every pixel of the canvas */
+    frame.hash = WatchFaceTrace::hash(canvas);
+
+    recorder->record(frame);
+}
+
+void WatchFaceUI::recordShownFrame(SharedPointer<FrameBuffer>& canvas,
+                                   int16_t xOffset,
+                                   int16_t yOffset,
+                                   uint32_t delay,
+                                   uint8_t modes)
+{
+    /*  Nothing is drawn from the clock, so it is read once, for the
+        timestamp, and the time is the one on screen.
+    */
+    watch_face_time_t shown;
+
+    shown.hour = hour_int;
+    shown.minute = minute_int;
+    shown.second = second_int;
+    shown.day = day_int;
+    shown.date = date_int;
+
+    recordFrame(canvas, xOffset, yOffset, clock->getTimeInMilliseconds(),
+                shown, delay, 0, modes);
+}
+
+void WatchFaceUI::renderFrame(SharedPointer<FrameBuffer>& canvas,
+                              int16_t xOffset,
+                              int16_t yOffset,
+                              const watch_face_time_t& now,
+                              uint32_t milliseconds)
+{
+    uint8_t new_hour = now.hour;
+    uint8_t new_minute = now.minute;
+    uint8_t new_date = now.date;
+    uint8_t new_day = now.day;
+
+    positions_t positions;
+
+    /****************************************************************************
+        Object creation
+    */
+
+    /*  Coming back from hidden, show the current time directly instead of
+        animating the minutes that were missed.
+    */
+    if (stale)
+    {
+        syncCells(now);
+
+        stale = false;
+    }
+
+    /*  Idle housekeeping: free the cells replaced by the last animation and
+        pre-stage cells for the coming hour.
+    */
+    if (animateMinute == false)
+    {
+        releaseRetiredCells();
+
+        if (needsPrestage() && (now.minute == 59))
+        {
+            prestageCells();
+        }
+    }
+
+    /*  SECONDS AND COMPLICATIONS
+        With the rest of the time on screen still current, only the seconds
+        and complications with new data are drawn over the frame kept in the
+        canvas.
+    */
+    if (isCanvasRetained(xOffset, yOffset) && (animateMinute == false) &&
+        (new_hour == hour_int) && (new_minute == minute_int) &&
+        (new_day == day_int) && (new_date == date_int))
+    {
+        if ((second_drawn >= 0) && (now.second != second_drawn))
+        {
+            drawSeconds(canvas, now.second);
+        }
+
+        drawComplications(canvas, xOffset, yOffset, true);
 
-    uint8_t new_date = Calendar::getDate();
-    uint8_t new_day = Calendar::getDay();
+        statistics.partialFrames++;
 
-    positions_t positions;
+        return;
+    }
 
-    /****************************************************************************
-        Object creation
+    /*  AMBIENT
     */
+    bool ambient = isAmbient(new_hour);
+
+    /* an animation in progress when entering ambient jumps to its end */
+    if (ambient && animateMinute)
+    {
+        completeMinuteAnimation();
+    }
 
     /* MINUTE
     */
@@ -280,36 +1432,64 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
     */
     if ((new_minute != minute_int) && (animateMinute == false))
     {
-        /*  Create new objects since we are animating the change. The next_ prefix
-            is used to show which object/variable it replaces.
-        */
         /* most significant minute digit */
         char next_minute_x0_array[2];
         next_minute_x0_array[0] = (new_minute / 10) + 48;
         next_minute_x0_array[1] = '\0';
 
-        next_minute_x0_cell = new UITextView(next_minute_x0_array, &Font_Minutes);
-
-        next_minute_x0_cell->prefetch(0, 0);
-        next_minute_x0_cell->setInverse(true);
-        next_minute_x0_cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
-        next_minute_x0_cell->setVerticalAlignment(UIView::VALIGN_TOP);
-
         /* least significant minute digit */
         char next_minute_0x_array[2];
         next_minute_0x_array[0] = (new_minute % 10) + 48;
         next_minute_0x_array[1] = '\0';
 
-        next_minute_0x_cell = new UITextView(next_minute_0x_array, &Font_Minutes);
-
-        next_minute_0x_cell->prefetch(0, 0);
-        next_minute_0x_cell->setInverse(true);
-        next_minute_0x_cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
-        next_minute_0x_cell->setVerticalAlignment(UIView::VALIGN_TOP);
+        uint8_t shown_minute = minute_int;
 
         minute_int = new_minute;
-        animateMinute = true;
-        animateStartTime = UIView::getTimeInMilliseconds();
+
+        if (ambient)
+        {
+            /*  No animation in ambient mode, swap the digits in place. Text
+                cells are recreated, so a digit that stays keeps its cell,
+                e.g. the tens for nine updates in ten with a one minute
+                interval, and both digits with a ten minute interval.
+            */
+            if ((new_minute / 10) != (shown_minute / 10))
+            {
+                replaceCell(&minute_x0_cell, next_minute_x0_array, FONT_MINUTES, fonts);
+            }
+
+            if ((new_minute % 10) != (shown_minute % 10))
+            {
+                replaceCell(&minute_0x_cell, next_minute_0x_array, FONT_MINUTES, fonts);
+            }
+
+            next_minute_x0_cell = minute_x0_cell;
+            next_minute_0x_cell = minute_0x_cell;
+
+            statistics.animationsSkipped++;
+        }
+        else
+        {
+            /*  Create new objects since we are animating the change. The next_ prefix
+                is used to show which object/variable it replaces.
+            */
+            next_minute_x0_cell = createCell(next_minute_x0_array, FONT_MINUTES, fonts, &grayFrame);
+
+            next_minute_x0_cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
+            next_minute_x0_cell->setVerticalAlignment(UIView::VALIGN_TOP);
+
+            next_minute_0x_cell = createCell(next_minute_0x_array, FONT_MINUTES, fonts, &grayFrame);
+
+            next_minute_0x_cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
+            next_minute_0x_cell->setVerticalAlignment(UIView::VALIGN_TOP);
+
+            animateMinute = true;
+            animateStartTime = milliseconds;
+            animationCpuTime = 0;
+            animationOverrun = 0;
+            statistics.animations++;
+            governor.animationStarted(transitionTimeInMilliSeconds);
+        }
     }
 
     /* HOUR
@@ -323,13 +1503,6 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
         next_hour_array[1] = (new_hour % 10) + 48;
         next_hour_array[2] = '\0';
 
-        next_hour_cell = new UITextView(next_hour_array, &Font_Hours);
-
-        next_hour_cell->prefetch(0, 0);
-        next_hour_cell->setInverse(true);
-        next_hour_cell->setHorizontalAlignment(UIView::ALIGN_RIGHT);
-        next_hour_cell->setVerticalAlignment(UIView::VALIGN_TOP);
-
         hour_int = new_hour;
 
         /*  If the hour changed without the minute changing as well,
@@ -337,27 +1510,53 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
             update immediately. Otherwise wait until the minute animation
             has completed before updating the hour.
         */
+        UIView* staged = takeStagedCell(&staged_hour_cell, staged_hour_int, new_hour);
+
         if (animateMinute == false)
         {
-            delete hour_cell;
-            hour_cell = next_hour_cell;
+            if (staged)
+            {
+                retireCell(hour_cell);
+                hour_cell = staged;
+            }
+            else
+            {
+                replaceCell(&hour_cell, next_hour_array, FONT_HOURS, fonts);
+            }
+
+            next_hour_cell = hour_cell;
+        }
+        else
+        {
+            next_hour_cell = (staged) ? staged : createCell(next_hour_array, FONT_HOURS, fonts, &grayFrame);
         }
+
+        next_hour_cell->setHorizontalAlignment(UIView::ALIGN_RIGHT);
+        next_hour_cell->setVerticalAlignment(UIView::VALIGN_TOP);
     }
 
     /*  DAY
     */
     if (new_day != day_int)
     {
-        /* The name of the day is stored in the array day_list. */
-        delete day_cell;
-        day_cell = new UITextView(day_list[new_day], &Font_Dayndate);
+        UIView* staged = takeStagedCell(&staged_day_cell, staged_day_int, new_day);
+
+        if (staged)
+        {
+            retireCell(day_cell);
+            day_cell = staged;
+        }
+        else
+        {
+            /* The name of the day is stored in the array day_list. */
+            replaceCell(&day_cell, day_list[new_day], FONT_DAYNDATE, fonts);
+        }
 
-        day_cell->prefetch(0, 0);
-        day_cell->setInverse(true);
         day_cell->setHorizontalAlignment(UIView::ALIGN_LEFT);
         day_cell->setVerticalAlignment(UIView::VALIGN_TOP);
 
         day_int = new_day;
+        scrollOffset = -1;
     }
 
     /*  DATE
@@ -369,19 +1568,45 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
         date_array[1] = (new_date % 10) + 48;
         date_array[2] = '\0';
 
-        delete date_cell;
-        date_cell = new UITextView(date_array, &Font_Dayndate);
+        UIView* staged = takeStagedCell(&staged_date_cell, staged_date_int, new_date);
+
+        if (staged)
+        {
+            retireCell(date_cell);
+            date_cell = staged;
+        }
+        else
+        {
+            replaceCell(&date_cell, date_array, FONT_DAYNDATE, fonts);
+        }
 
-        date_cell->prefetch(0, 0);
-        date_cell->setInverse(true);
         date_cell->setHorizontalAlignment(UIView::ALIGN_RIGHT);
         date_cell->setVerticalAlignment(UIView::VALIGN_TOP);
 
         date_int = new_date;
+        scrollOffset = -1;
     }
 
+    /* layout from metrics, ahead of drawing */
+    updateLayout();
+
     /* Propagate xOffset and yOffset from parent to child objects. */
 
+    /*  Move the rolling digits on screen instead of redrawing the face when
+        the rows drawn last frame can be reused.
+    */
+    if (animateMinute && rowScroll && scrollFrame(canvas, xOffset, yOffset, milliseconds))
+    {
+        drawComplications(canvas, xOffset, yOffset, true);
+
+        statistics.scrollFrames++;
+
+        return;
+    }
+
+    /* rows on screen are only reused between frames of the same roll */
+    scrollOffset = -1;
+
     /* fill canvas with black */
     canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 0);
 
@@ -391,21 +1616,40 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
             Ideally the offset increment should be a function of how long ago the
             last call came.
         */
-        uint32_t now = UIView::getTimeInMilliseconds();
-        uint32_t progress = now - animateStartTime;
-        uint32_t animateOffset = (height * progress) / transitionTimeInMilliSeconds;
+        uint32_t progress = milliseconds - animateStartTime;
+        uint32_t fraction = easeProgress(progress);
+        int32_t animateOffset = (height * fraction) >> EASING_SHIFT;
 
         /*  Calculate positions and offsets for all UIView compoinents.
             Animation positions and offsets are calculated locally.
         */
-        calculateCenter(&positions, progress, transitionTimeInMilliSeconds);
+        calculateCenter(&positions, fraction);
         calculatePositions(&positions, xOffset, yOffset);
 
-        /*  The animation is over when the offset has been cycled through a
-            complete perceived height.
+        /*  The animation is over when the transition time has passed. The
+            offset has then been cycled through a complete perceived height,
+            possibly after overshooting it.
+
+            The watchdog cuts the animation short when frames have overrun
+            their budget or the animation has used its share of CPU, so a
+            slow system never spends more than a bounded amount of time per
+            minute on the roll.
         */
-        if (animateOffset < height)
+        bool snap = watchdogExpired();
+
+        if (snap && (progress < transitionTimeInMilliSeconds))
+        {
+            statistics.animationsSnapped++;
+        }
+
+        if ((progress < transitionTimeInMilliSeconds) && !snap)
         {
+            if ((xOffset == 0) && (yOffset == 0))
+            {
+                scrollOffset = animateOffset;
+                scrollLeft = positions.left_margin;
+            }
+
             /*  Digits are animated individually and only when they change.
             */
             if ((minute_int % 10) == 0)
@@ -538,31 +1782,12 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
         else
         {
             /*  Animation is complete when the animateOffset is larger than the
-                percevied screen height. Cleanup by replacing the old objects
-                with the new ones.
+                percevied screen height, or when the watchdog snapped it to
+                its final state.
             */
-            animateMinute = false;
-
-            if (hour_cell != next_hour_cell)
-            {
-                delete hour_cell;
-
-                hour_cell = next_hour_cell;
-            }
-
-            if (minute_x0_cell != next_minute_x0_cell)
-            {
-                delete minute_x0_cell;
-
-                minute_x0_cell = next_minute_x0_cell;
-            }
-
-            if (minute_0x_cell != next_minute_0x_cell)
-            {
-                delete minute_0x_cell;
+            completeMinuteAnimation();
 
-                minute_0x_cell = next_minute_0x_cell;
-            }
+            calculateCenter(&positions, EASING_ONE);
 
             /*  Update positions for UIView elements now that the animation
                 is over.
@@ -600,7 +1825,7 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
         /*  Calculate positions and offsets for all UIView compoinents.
             Animation positions and offsets are calculated locally.
         */
-        calculateCenter(&positions, 0, 0);
+        calculateCenter(&positions, EASING_ONE);
         calculatePositions(&positions, xOffset, yOffset);
 
         /* Update screen with the stationary digits */
@@ -673,10 +1898,372 @@ uint32_t WatchFaceUI::fillFrameBuffer(SharedPointer<FrameBuffer>& canvas,
                                positions.date_x_offset,
                                positions.date_y_offset);
 
+
+    /*  SECONDS
+    */
+
+    /* right aligned with the minutes, line_space above the bottom edge */
+    second_drawn = -1;
+
+    if (seconds && !ambient)
+    {
+        int32_t yBase = (yOffset < 0) ? yOffset : 0;
+
+        seconds_rect.width = 2 * second_width;
+        seconds_rect.height = second_cells[0]->getHeight();
+        seconds_rect.x = positions.minute_0x_x + minute_0x_cell->getWidth()
+                                               - seconds_rect.width;
+        seconds_rect.y = yBase + height - line_space - seconds_rect.height;
+
+        drawSeconds(canvas, now.second);
+    }
+
+
+    /*  COMPLICATIONS
+    */
+    drawComplications(canvas, xOffset, yOffset, false);
+
+    canvasDrawn = (xOffset == 0) && (yOffset == 0);
+    drawnWidth = width;
+    drawnHeight = height;
+
+}
+
+uint32_t WatchFaceUI::idleDelay(const watch_face_time_t& now, bool ambient)
+{
+    governor.idle();
+
+    /* come back shortly to pre-stage the next hour while nothing else runs */
+    if (needsPrestage())
+    {
+        return PRESTAGE_DELAY_MS;
+    }
+
 #if WATCH_FACE_DEBUG
-    return (animateMinute) ? FRAME_LIMIT_MS : 100;
+    return 100;
 #else
+    if (seconds && !ambient)
+    {
+        return SECONDS_DELAY_MS;
+    }
+
+    if (ambient)
+    {
+        /*  Sleep until the next multiple of the ambient interval. Each
+            minute boundary slept through is a wakeup saved.
+        */
+        uint32_t minutes = ambientInterval - (now.minute % ambientInterval);
+
+        statistics.ambientWakeups++;
+        statistics.wakeupsSaved += minutes - 1;
+
+        return (minutes * 60 - now.second) * 1000;
+    }
+
     // update watch face every minute if animation not in progress
-    return (animateMinute) ? FRAME_LIMIT_MS : (60 - new_second) * 1000;
+    return (60 - now.second) * 1000;
+#endif
+}
+
+uint32_t WatchFaceUI::animationDelay(uint32_t milliseconds)
+{
+    /* let the governor pace the animation from the measured frame cost */
+    uint32_t progress = milliseconds - animateStartTime;
+    uint32_t remaining = (progress < transitionTimeInMilliSeconds)
+                         ? transitionTimeInMilliSeconds - progress : 0;
+
+    return governor.frameFinished(milliseconds, remaining);
+}
+
+bool WatchFaceUI::watchdogExpired() const
+{
+    /* limits come from the governor's profile, see WATCH_FACE_FRAME_PROFILE */
+    const WatchFaceFrameGovernor::watchdog_t& watchdog = governor.getWatchdog();
+
+    return (animationOverrun >= watchdog.overrunLimit) ||
+           (animationCpuTime >= watchdog.cpuLimit);
+}
+
+static bool overlaps(int32_t a0, int32_t a1, int32_t b0, int32_t b1)
+{
+    return (a0 < b1) && (b0 < a1);
+}
+
+void WatchFaceUI::drawCellRows(SharedPointer<FrameBuffer>& canvas, UIView* cell,
+                               int32_t x, int32_t y, int32_t top, int32_t bottom)
+{
+    int32_t y0 = (y > top) ? y : top;
+    int32_t y1 = y + cell->getHeight();
+
+    if (y1 > bottom)
+    {
+        y1 = bottom;
+    }
+
+    if (y0 >= y1)
+    {
+        return;
+    }
+
+    /* rows above the band are passed as a negative offset into the cell */
+    SharedPointer<FrameBuffer> rows = canvas->getFrameBuffer(x, y0, cell->getWidth(), y1 - y0);
+
+    cell->fillFrameBuffer(rows, 0, y - y0);
+}
+
+bool WatchFaceUI::scrollFrame(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset,
+                              uint32_t milliseconds)
+{
+    /*  Rows on screen are only reusable when the face has not moved since
+        the last frame of this roll, and can only be moved on the canvas
+        set as able to. Other canvases are redrawn every frame.
+    */
+    if ((scrollCanvas == NULL) || (canvas.get() != scrollCanvas) || (scrollOffset < 0) ||
+        (xOffset != 0) || (yOffset != 0) || (canvas->getHeight() != height))
+    {
+        return false;
+    }
+
+    uint32_t progress = milliseconds - animateStartTime;
+
+    bool snap = watchdogExpired();
+
+    /* the last frame of the roll is always drawn in full */
+    if ((progress >= transitionTimeInMilliSeconds) || snap)
+    {
+        return false;
+    }
+
+    uint32_t fraction = easeProgress(progress);
+    int32_t animateOffset = (height * fraction) >> EASING_SHIFT;
+    int32_t delta = animateOffset - scrollOffset;
+
+    positions_t positions;
+    calculateCenter(&positions, fraction);
+    calculatePositions(&positions, 0, 0);
+
+    /* a sliding margin moves every cell, and easing overshoot scrolls down */
+    if ((positions.left_margin != scrollLeft) || (delta < 0) || (delta >= (int32_t) height))
+    {
+        return false;
+    }
+
+    /*  The column spans the digits that change, wide enough for both the
+        old and the new ones.
+    */
+    bool both = ((minute_int % 10) == 0);
+
+    int32_t next_minute_0x_x = (both) ? positions.minute_x0_x +
+                                        next_minute_x0_cell->getWidth() +
+                                        minute_kerning
+                                      : positions.minute_0x_x;
+
+    int32_t x0 = (both) ? positions.minute_x0_x : positions.minute_0x_x;
+    int32_t x1 = positions.minute_0x_x + minute_0x_cell->getWidth();
+    int32_t next_x1 = next_minute_0x_x + next_minute_0x_cell->getWidth();
+
+    if (x1 < next_x1)
+    {
+        x1 = next_x1;
+    }
+
+    if (x1 > canvas->getWidth())
+    {
+        x1 = canvas->getWidth();
+    }
+
+    /* nothing else may share the column */
+    if ((x0 < 0) || (x0 >= x1) ||
+        overlaps(x0, x1, positions.hour_x, positions.hour_x + hour_cell->getWidth()) ||
+        overlaps(x0, x1, positions.day_x, positions.day_x + day_cell->getWidth()) ||
+        overlaps(x0, x1, positions.date_x, positions.date_x + day_cell->getWidth()))
+    {
+        return false;
+    }
+
+    if ((second_drawn >= 0) &&
+        overlaps(x0, x1, seconds_rect.x, seconds_rect.x + seconds_rect.width))
+    {
+        return false;
+    }
+
+    for (uint8_t index = 0; index < complicationCount; index++)
+    {
+        const watch_face_rect_t& region = complications[index].region;
+
+        if (overlaps(x0, x1, region.x, region.x + region.width))
+        {
+            return false;
+        }
+    }
+
+    if (delta > 0)
+    {
+        int32_t top = height - delta;
+
+        scrollCanvas->scrollUp(x0, x1, 0, height, delta);
+        canvas->drawRectangle(x0, x1, top, height, 0);
+
+        /*  Redraw the exposed rows at the bottom, which hold the incoming
+            digits and possibly the tail of the outgoing ones.
+        */
+        int32_t minute_0x_y = positions.minute_0x_y - animateOffset;
+
+        drawCellRows(canvas, minute_0x_cell, positions.minute_0x_x, minute_0x_y, top, height);
+        drawCellRows(canvas, next_minute_0x_cell, next_minute_0x_x, minute_0x_y + height, top, height);
+
+        if (both)
+        {
+            int32_t minute_x0_y = positions.minute_x0_y - animateOffset;
+
+            drawCellRows(canvas, minute_x0_cell, positions.minute_x0_x, minute_x0_y, top, height);
+            drawCellRows(canvas, next_minute_x0_cell, positions.minute_x0_x, minute_x0_y + height, top, height);
+        }
+    }
+
+    scrollOffset = animateOffset;
+
+    return true;
+}
+
+/*  Refreshes may come early by up to a fraction 1 / COMPLICATION_SLACK of the
+    interval, so a complication refreshing less often than the face wakes
+    up never needs a wakeup of its own.
+*/
+#define COMPLICATION_SLACK 4
+
+void WatchFaceUI::updateComplications(uint32_t milliseconds, const watch_face_time_t& now)
+{
+    for (uint8_t index = 0; index < complicationCount; index++)
+    {
+        complication_slot_t* slot = &complications[index];
+
+        uint32_t slack = slot->interval / COMPLICATION_SLACK;
+
+        if ((int32_t) (milliseconds - (slot->deadline - slack)) >= 0)
+        {
+            if (slot->complication->update(now))
+            {
+                slot->changed = true;
+            }
+
+            slot->deadline = milliseconds + slot->interval;
+
+            statistics.complicationUpdates++;
+        }
+    }
+}
+
+uint32_t WatchFaceUI::complicationDelay(uint32_t milliseconds, uint32_t delay) const
+{
+    for (uint8_t index = 0; index < complicationCount; index++)
+    {
+        int32_t due = complications[index].deadline - milliseconds;
+
+        if ((due >= 0) && ((uint32_t) due < delay))
+        {
+            delay = due;
+        }
+    }
+
+    return delay;
+}
+
+void WatchFaceUI::drawComplications(SharedPointer<FrameBuffer>& canvas,
+                                    int16_t xOffset, int16_t yOffset, bool changed)
+{
+    /* same camera offset as the cells */
+    int32_t xBase = (xOffset < 0) ? xOffset : 0;
+    int32_t yBase = (yOffset < 0) ? yOffset : 0;
+
+    for (uint8_t index = 0; index < complicationCount; index++)
+    {
+        complication_slot_t* slot = &complications[index];
+
+        if (changed && (slot->changed == false))
+        {
+            continue;
+        }
+
+        int32_t x = xBase + slot->region.x;
+        int32_t y = yBase + slot->region.y;
+
+        SharedPointer<FrameBuffer> region = canvas->getFrameBuffer(x, y,
+                                                                   slot->region.width,
+                                                                   slot->region.height);
+
+        region->drawRectangle(0, region->getWidth(), 0, region->getHeight(), 0);
+
+        slot->complication->draw(region, (x < 0) ? x : 0, (y < 0) ? y : 0);
+        slot->changed = false;
+
+        complicationsDrawn |= (1 << index);
+        statistics.complicationDraws++;
+    }
+}
+
+void WatchFaceUI::drawSeconds(SharedPointer<FrameBuffer>& canvas, uint8_t second)
+{
+    /*  The rectangle is cleared in the canvas itself rather than through a
+        sub-canvas, so a tick allocates nothing beyond the digits' canvases,
+        and with glyph packs nothing at all.
+    */
+    uint16_t x0 = (seconds_rect.x > 0) ? seconds_rect.x : 0;
+    uint16_t y0 = (seconds_rect.y > 0) ? seconds_rect.y : 0;
+    int32_t x1 = seconds_rect.x + seconds_rect.width;
+    int32_t y1 = seconds_rect.y + seconds_rect.height;
+
+    x1 = (x1 < canvas->getWidth()) ? x1 : canvas->getWidth();
+    y1 = (y1 < canvas->getHeight()) ? y1 : canvas->getHeight();
+
+    if ((x1 > x0) && (y1 > y0))
+    {
+        canvas->drawRectangle(x0, x1, y0, y1, 0);
+    }
+
+    /* digits on a fixed pitch so the readout does not jitter */
+    uint8_t digits[2] = { (uint8_t) (second / 10), (uint8_t) (second % 10) };
+
+    for (uint8_t index = 0; index < 2; index++)
+    {
+        int32_t x = seconds_rect.x + index * second_width;
+        int32_t y = seconds_rect.y;
+
+#if WATCH_FACE_GLYPH_PACK
+        /* ink straight from flash onto the cleared rectangle */
+        char digit_array[2];
+        digit_array[0] = digits[index] + 48;
+        digit_array[1] = '\0';
+
+        const glyph_pack_entry_t* entry = glyphPackFind(fonts->seconds, digit_array);
+
+        if (entry)
+        {
+            glyphPackDrawInk(fonts->seconds, entry, canvas, x, y, true,
+                             (grayFrame) ? grayCanvas : NULL);
+        }
+#else
+        UIView* cell = second_cells[digits[index]];
+
+        SharedPointer<FrameBuffer> digit_canvas =
+                                 canvas->getFrameBuffer(x, y,
+                                                        cell->getWidth(),
+                                                        cell->getHeight());
+
+        cell->fillFrameBuffer(digit_canvas,
+                              (x < 0) ? x : 0,
+                              (y < 0) ? y : 0);
 #endif
+    }
+
+    second_drawn = second;
+    seconds_damaged = true;
+    statistics.secondsDraws++;
+}
+
+bool WatchFaceUI::isCanvasRetained(int16_t xOffset, int16_t yOffset) const
+{
+    return retainedCanvas && canvasDrawn &&
+           (xOffset == 0) && (yOffset == 0) &&
+           (drawnWidth == width) && (drawnHeight == height);
 }
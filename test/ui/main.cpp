@@ -16,8 +16,10 @@
  */
 
 #include "mbed-drivers/mbed.h"
+#include "minar/minar.h"
 
 #include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/WatchFaceRegistry.h"
 
 #include "uiframework/UIFramework.h"
 #include "uif-matrixlcd/MatrixLCD.h"
@@ -25,13 +27,55 @@
 static SPI lcdspi(LCD_SPI_MOSI, NC, LCD_SPI_CLK);
 static uif::MatrixLCD lcd(lcdspi, LCD_CS, LCD_DISP, LCD_EXT_COM_IN);
 static SharedPointer<UIFramework> uiFramework;
+static WatchFaceRegistry* registry;
+
+// Delay between switching faces.
+#define SWITCH_DELAY_MS 30000
+
+static WatchFaceUI* createFace(SharedPointer<WatchFaceClock> clock, const watch_face_state_t* state)
+{
+    return (state) ? new WatchFaceUI(clock, *state) : new WatchFaceUI(clock);
+}
+
+static WatchFaceUI* createSecondsFace(SharedPointer<WatchFaceClock> clock, const watch_face_state_t* state)
+{
+    if (state)
+    {
+        return new WatchFaceUI(clock, *state);
+    }
+
+    WatchFaceUI* face = new WatchFaceUI(clock);
+    face->setSeconds(true);
+
+    return face;
+}
+
+static void switchFace()
+{
+    // the other face is shown from the next frame on
+    registry->select((registry->getSelected() + 1) % 2);
+
+    printf("registry: face %d, switch %u ms, inactive %u bytes\r\n",
+           registry->getSelected(),
+           registry->getStatistics().lastSwitchTime,
+           registry->getStatistics().inactiveBytes);
+}
 
 void app_start(int, char *[])
 {
-    SharedPointer<UIView> view(new WatchFaceUI());
+    SharedPointer<WatchFaceClock> clock(new WatchFaceCalendarClock());
+
+    // faces, switched with WatchFaceRegistry::select
+    registry = new WatchFaceRegistry(clock);
+    registry->add(createFace);
+    registry->add(createSecondsFace);
+
+    SharedPointer<UIView> view(registry);
     view->setWidth(128);
     view->setHeight(128);
 
     // UI framework
     uiFramework = SharedPointer<UIFramework>(new UIFramework(lcd, view));
+
+    minar::Scheduler::postCallback(switchFace).period(minar::milliseconds(SWITCH_DELAY_MS));
 }
@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool checking the allocation budgets of the face and menu tables.
+
+    Usage: allocbudget [-v]
+
+    Each check runs a hot path inside a WatchFaceAllocationScope, with
+    operator new and delete replaced by this tool to count every
+    allocation, and compares the count with the path's budget:
+
+    frame at rest       a frame on a retained canvas in the same minute
+                        as the last one, 0
+    full frame          the same without a retained canvas, a
+                        sub-canvas for each of the five cells,
+                        FULL_FRAME_BUDGET
+    seconds tick        a frame only updating the seconds, a sub-canvas
+                        for each digit, SECONDS_TICK_BUDGET, 0 with
+                        WATCH_FACE_GLYPH_PACK
+    minute roll         every frame from the minute changing until the
+                        face is at rest again, MINUTE_ROLL_BUDGET
+    hour roll           the same when the hour changes too,
+                        HOUR_ROLL_BUDGET
+    layout              getSize, heightAtIndex and widthAtIndex of every
+                        row of a Set*MenuTable, 0
+    views               viewAtIndex of rows already drawn, the view and
+                        its SharedPointer count, 2 per row
+    visible rows        MenuTable::fillVisibleRows over rows drawn in the
+                        frame before, 0
+
+    Each sub-canvas is a FrameBuffer and a SharedPointer count, 2
+    allocations.
+
+    A check over budget prints every call site that allocated, as the
+    function and file:line found by addr2line, or the offset into the
+    executable when that fails. -v prints the sites of every check. The
+    exit status is 1 when any check is over budget.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, with WATCH_FACE_ALLOCATION_HOOK
+    left at 0 and debug information for the call sites, e.g.:
+    g++ -g -O1 -I. <dependency include paths> -o allocbudget tools/allocbudget/allocbudget.cpp <module and dependency sources> -ldl
+*/
+
+#include "uif-ui-watch-face-wrd/WatchFaceAllocation.h"
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/SetDateMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetHourMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetMinuteMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetMonthMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetTimeMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetYearMenuTable.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <dlfcn.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#define PANEL_SIZE 128
+
+#if WATCH_FACE_ALLOCATION_HOOK
+#error "allocbudget defines its own operator new, build it with WATCH_FACE_ALLOCATION_HOOK 0"
+#endif
+
+#define FULL_FRAME_BUDGET 10
+
+#if WATCH_FACE_GLYPH_PACK
+#define SECONDS_TICK_BUDGET 0
+#else
+#define SECONDS_TICK_BUDGET 4
+#endif
+
+/*  The cells for the new digits, then a sub-canvas per cell and frame.
+*/
+#define MINUTE_ROLL_BUDGET 80
+#define HOUR_ROLL_BUDGET 90
+
+#define VIEW_BUDGET 2
+#define VIEW_ROWS 4
+
+/*  A frame delay at least this long means the face is at rest.
+*/
+#define REST_DELAY_MS 1000
+
+#define MENU_TABLES 6
+
+/*****************************************************************************/
+/* Hook                                                                      */
+/*****************************************************************************/
+
+void* operator new(size_t size)
+{
+    WatchFaceAllocationScope::recordAllocation(size, __builtin_return_address(0));
+
+    void* pointer = malloc((size > 0) ? size : 1);
+
+    if (pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    WatchFaceAllocationScope::recordAllocation(size, __builtin_return_address(0));
+
+    void* pointer = malloc((size > 0) ? size : 1);
+
+    if (pointer == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pointer;
+}
+
+void operator delete(void* pointer) throw()
+{
+    if (pointer)
+    {
+        WatchFaceAllocationScope::recordRelease();
+        free(pointer);
+    }
+}
+
+void operator delete[](void* pointer) throw()
+{
+    if (pointer)
+    {
+        WatchFaceAllocationScope::recordRelease();
+        free(pointer);
+    }
+}
+
+/*****************************************************************************/
+/* Checks                                                                    */
+/*****************************************************************************/
+
+static bool verbose = false;
+static uint32_t failures = 0;
+
+static void printSite(const WatchFaceAllocationScope::site_t& site)
+{
+    /* the return address is just past the call */
+    const char* address = (const char*) site.site - 1;
+    Dl_info info;
+    char location[256] = "";
+
+    if (dladdr(address, &info) && info.dli_fname)
+    {
+        char command[512];
+        unsigned long offset = address - (const char*) info.dli_fbase;
+
+        snprintf(command, sizeof(command), "addr2line -C -f -p -e %s 0x%lx 2>/dev/null",
+                 info.dli_fname, offset);
+
+        FILE* pipe = popen(command, "r");
+
+        if ((pipe == NULL) || (fgets(location, sizeof(location), pipe) == NULL) ||
+            (strstr(location, "??")))
+        {
+            snprintf(location, sizeof(location), "%s+0x%lx\n", info.dli_fname, offset);
+        }
+
+        if (pipe)
+        {
+            pclose(pipe);
+        }
+    }
+    else
+    {
+        snprintf(location, sizeof(location), "%p\n", site.site);
+    }
+
+    printf("    %4u allocations %6u bytes  %s", site.allocations, site.bytes, location);
+}
+
+static void check(const char* name, const WatchFaceAllocationScope& scope, uint32_t budget)
+{
+    bool over = (scope.getAllocations() > budget);
+
+    printf("%s %-32s %5u allocations, budget %u\n", (over) ? "FAIL" : "ok  ", name,
+           scope.getAllocations(), budget);
+
+    if (over || verbose)
+    {
+        for (uint32_t index = 0; index < scope.getSites(); index++)
+        {
+            printSite(scope.getSite(index));
+        }
+    }
+
+    if (over)
+    {
+        failures++;
+    }
+}
+
+/*  Draw frames until the face asks for a delay of a second or more.
+    @return Milliseconds the frames took on the clock.
+*/
+static uint32_t settle(WatchFaceUI& face, WatchFaceVirtualClock* clock, SharedPointer<FrameBuffer>& canvas)
+{
+    uint32_t elapsed = 0;
+    uint32_t delay;
+
+    do
+    {
+        delay = face.fillFrameBuffer(canvas, 0, 0);
+
+        if (delay < REST_DELAY_MS)
+        {
+            clock->advance(delay);
+            elapsed += delay;
+        }
+    } while (delay < REST_DELAY_MS);
+
+    return elapsed;
+}
+
+static void checkFace(SharedPointer<FrameBuffer>& canvas)
+{
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(10, 58, 30, 1, 1);
+
+    WatchFaceUI face(clock);
+    face.setWidth(canvas->getWidth());
+    face.setHeight(canvas->getHeight());
+    face.setRetainedCanvas(true);
+
+    settle(face, virtualClock, canvas);
+    virtualClock->advance(REST_DELAY_MS);
+
+    {
+        WatchFaceAllocationScope scope;
+        face.fillFrameBuffer(canvas, 0, 0);
+        check("frame at rest", scope, 0);
+    }
+
+    face.setRetainedCanvas(false);
+    virtualClock->advance(REST_DELAY_MS);
+
+    {
+        WatchFaceAllocationScope scope;
+        face.fillFrameBuffer(canvas, 0, 0);
+        check("full frame", scope, FULL_FRAME_BUDGET);
+    }
+
+    virtualClock->set(10, 59, 0, 1, 1);
+
+    {
+        WatchFaceAllocationScope scope;
+        settle(face, virtualClock, canvas);
+        check("minute roll", scope, MINUTE_ROLL_BUDGET);
+    }
+
+    virtualClock->set(11, 0, 0, 1, 1);
+
+    {
+        WatchFaceAllocationScope scope;
+        settle(face, virtualClock, canvas);
+        check("hour roll", scope, HOUR_ROLL_BUDGET);
+    }
+}
+
+static void checkSeconds(SharedPointer<FrameBuffer>& canvas)
+{
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(10, 0, 10, 1, 1);
+
+    WatchFaceUI face(clock);
+    face.setWidth(canvas->getWidth());
+    face.setHeight(canvas->getHeight());
+    face.setRetainedCanvas(true);
+    face.setSeconds(true);
+
+    virtualClock->advance(face.fillFrameBuffer(canvas, 0, 0));
+
+    {
+        WatchFaceAllocationScope scope;
+        face.fillFrameBuffer(canvas, 0, 0);
+        check("seconds tick", scope, SECONDS_TICK_BUDGET);
+    }
+}
+
+static MenuTable* createTable(uint32_t index, const char** name)
+{
+    switch (index)
+    {
+        case 0:
+            *name = "SetTimeMenuTable";
+            return new SetTimeMenuTable();
+        case 1:
+            *name = "SetHourMenuTable";
+            return new SetHourMenuTable();
+        case 2:
+            *name = "SetMinuteMenuTable";
+            return new SetMinuteMenuTable();
+        case 3:
+            *name = "SetDateMenuTable";
+            return new SetDateMenuTable();
+        case 4:
+            *name = "SetMonthMenuTable";
+            return new SetMonthMenuTable();
+        case 5:
+        default:
+            *name = "SetYearMenuTable";
+            return new SetYearMenuTable();
+    }
+}
+
+static void checkTables(SharedPointer<FrameBuffer>& canvas)
+{
+    /* the tables themselves are not part of the budgets */
+    for (uint32_t table = 0; table < MENU_TABLES; table++)
+    {
+        const char* name;
+        MenuTable* menu = createTable(table, &name);
+        char title[64];
+
+        {
+            WatchFaceAllocationScope scope;
+
+            for (uint32_t index = 0; index < menu->getSize(); index++)
+            {
+                menu->heightAtIndex(index);
+                menu->widthAtIndex(index);
+            }
+
+            snprintf(title, sizeof(title), "%s layout", name);
+            check(title, scope, 0);
+        }
+
+        /* rows in view from the default one, as drawn before */
+        uint32_t first = menu->getDefaultIndex();
+        uint32_t rows = (first + VIEW_ROWS <= menu->getSize()) ? VIEW_ROWS : menu->getSize() - first;
+
+        for (uint32_t index = first; index < first + rows; index++)
+        {
+            menu->viewAtIndex(index);
+        }
+
+        {
+            WatchFaceAllocationScope scope;
+
+            for (uint32_t index = first; index < first + rows; index++)
+            {
+                menu->viewAtIndex(index);
+            }
+
+            snprintf(title, sizeof(title), "%s views", name);
+            check(title, scope, VIEW_BUDGET * rows);
+        }
+
+        uint32_t offset = menu->heightAtIndex(0) / 2;
+
+        menu->fillVisibleRows(canvas, offset);
+
+        {
+            WatchFaceAllocationScope scope;
+            menu->fillVisibleRows(canvas, offset + 1);
+
+            snprintf(title, sizeof(title), "%s visible rows", name);
+            check(title, scope, 0);
+        }
+
+        delete menu;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int argument = 1;
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if (strcmp(argv[argument], "-v") == 0)
+        {
+            verbose = true;
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    if (argument != argc)
+    {
+        fprintf(stderr, "usage: %s [-v]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static uint8_t bits[PANEL_SIZE * PANEL_SIZE / 8];
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(bits, PANEL_SIZE / 8, 0, 0,
+                                                          PANEL_SIZE, PANEL_SIZE));
+
+    checkFace(canvas);
+    checkSeconds(canvas);
+    checkTables(canvas);
+
+    return (failures > 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool rendering the face for every time of day and every day/date.
+
+    Usage: batchrender [-j <threads>] [-p <size>] [-f pbm|packed] [-o <output>]
+
+    Renders 1440 states, one per hour:minute on Sunday the 1st, followed by
+    217, one per day of the week and date at 12:00. Each state gets its own
+    WatchFaceUI on its own WatchFaceVirtualClock, set before the face is
+    created, and the face's first frame is kept. The states are spread over
+    -j threads (one per online CPU by default) by a work-stealing pool: each
+    thread starts with an equal share and, once done, takes half of what is
+    left of another thread's share.
+
+    -p  Panel size in pixels, WATCH_FACE_PANEL_WIDTH by default.
+    -f  Output format, with -o:
+        pbm     <output>/HH-MM.pbm and <output>/day-D-DD.pbm, raw PBM with
+                lit pixels white.
+        packed  One file: "WFB1", width and height as 16 bit and the number
+                of states as 32 bit little endian values, then for every
+                state its hour, minute, day and date bytes followed by the
+                canvas rows, 1 bit per pixel, lit pixels set, most
+                significant bit first, rows padded to whole bytes.
+    -o  Where to write the frames. Without it the frames are only rendered.
+
+    Prints the frames rendered, steals and frames per second of CPU time by
+    each thread, and the total frames per second and per core over the wall
+    clock time of the run.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, e.g.:
+    g++ -O2 -pthread -I. <dependency include paths> -o batchrender tools/batchrender/batchrender.cpp <module and dependency sources>
+*/
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#define MAX_THREADS 64
+
+#define TIME_STATES (24 * 60)
+#define DATE_STATES (7 * 31)
+#define STATES (TIME_STATES + DATE_STATES)
+
+#define PACKED_MAGIC "WFB1"
+
+typedef struct {
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t day;
+    uint8_t date;
+} state_t;
+
+/*  Share of the states owned by one thread. The owner takes states from
+    next, thieves take the upper half of what is left by lowering end.
+*/
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t next;
+    uint32_t end;
+    uint32_t frames;
+    uint32_t steals;
+    double cpuTime;
+} worker_t;
+
+static worker_t workers[MAX_THREADS];
+static uint32_t threads = 0;
+
+static uint16_t panelSize = WATCH_FACE_PANEL_WIDTH;
+static uint32_t stride = 0;
+static uint8_t* frames = NULL;
+
+static void getState(uint32_t index, state_t* state)
+{
+    if (index < TIME_STATES)
+    {
+        state->hour = index / 60;
+        state->minute = index % 60;
+        state->day = 0;
+        state->date = 1;
+    }
+    else
+    {
+        index -= TIME_STATES;
+
+        state->hour = 12;
+        state->minute = 0;
+        state->day = index / 31;
+        state->date = (index % 31) + 1;
+    }
+}
+
+static double getTime(clockid_t clock)
+{
+    struct timespec now;
+    clock_gettime(clock, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+static void render(uint32_t index)
+{
+    state_t state;
+    getState(index, &state);
+
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(state.hour, state.minute, 0, state.day, state.date);
+
+    WatchFaceUI face(clock);
+    face.setWidth(panelSize);
+    face.setHeight(panelSize);
+
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(&frames[index * stride * panelSize], stride,
+                                                          0, 0, panelSize, panelSize));
+
+    face.fillFrameBuffer(canvas, 0, 0);
+}
+
+/*  Take the next state from the thread's own share, or steal half of the
+    largest share left. Returns false when no state is left anywhere.
+*/
+static bool takeState(uint32_t self, uint32_t* index)
+{
+    worker_t* worker = &workers[self];
+
+    pthread_mutex_lock(&worker->lock);
+
+    bool found = (worker->next < worker->end);
+
+    if (found)
+    {
+        *index = worker->next++;
+    }
+
+    pthread_mutex_unlock(&worker->lock);
+
+    while (found == false)
+    {
+        uint32_t victim = self;
+        uint32_t largest = 0;
+
+        for (uint32_t other = 0; other < threads; other++)
+        {
+            pthread_mutex_lock(&workers[other].lock);
+
+            uint32_t left = workers[other].end - workers[other].next;
+
+            pthread_mutex_unlock(&workers[other].lock);
+
+            if ((other != self) && (left > largest))
+            {
+                victim = other;
+                largest = left;
+            }
+        }
+
+        if (largest == 0)
+        {
+            return false;
+        }
+
+        /* the share may have shrunk since it was looked at, then look again */
+        pthread_mutex_lock(&workers[victim].lock);
+
+        uint32_t next = workers[victim].next;
+        uint32_t end = workers[victim].end;
+        uint32_t start = end - (end - next) / 2;
+
+        if (next < end)
+        {
+            /* a single state left is taken whole */
+            start = (start < end) ? start : next;
+            workers[victim].end = start;
+        }
+
+        pthread_mutex_unlock(&workers[victim].lock);
+
+        if (next < end)
+        {
+            pthread_mutex_lock(&worker->lock);
+
+            worker->next = start + 1;
+            worker->end = end;
+            worker->steals++;
+
+            pthread_mutex_unlock(&worker->lock);
+
+            *index = start;
+            found = true;
+        }
+    }
+
+    return true;
+}
+
+static void* work(void* argument)
+{
+    uint32_t self = (uint32_t) (size_t) argument;
+    double start = getTime(CLOCK_THREAD_CPUTIME_ID);
+    uint32_t index;
+
+    while (takeState(self, &index))
+    {
+        render(index);
+
+        workers[self].frames++;
+    }
+
+    workers[self].cpuTime = getTime(CLOCK_THREAD_CPUTIME_ID) - start;
+
+    return NULL;
+}
+
+static bool writePBM(const std::string& directory)
+{
+    for (uint32_t index = 0; index < STATES; index++)
+    {
+        state_t state;
+        getState(index, &state);
+
+        char name[32];
+
+        if (index < TIME_STATES)
+        {
+            snprintf(name, sizeof(name), "/%02u-%02u.pbm", state.hour, state.minute);
+        }
+        else
+        {
+            snprintf(name, sizeof(name), "/day-%u-%02u.pbm", state.day, state.date);
+        }
+
+        FILE* file = fopen((directory + name).c_str(), "wb");
+
+        if (file == NULL)
+        {
+            return false;
+        }
+
+        fprintf(file, "P4\n%u %u\n", panelSize, panelSize);
+
+        /* black is ink in PBM, the display shows lit pixels white */
+        const uint8_t* bits = &frames[index * stride * panelSize];
+
+        for (uint32_t byte = 0; byte < stride * panelSize; byte++)
+        {
+            fputc(~bits[byte] & 0xFF, file);
+        }
+
+        fclose(file);
+    }
+
+    return true;
+}
+
+static void put16(FILE* file, uint16_t value)
+{
+    fputc(value & 0xFF, file);
+    fputc(value >> 8, file);
+}
+
+static void put32(FILE* file, uint32_t value)
+{
+    put16(file, value & 0xFFFF);
+    put16(file, value >> 16);
+}
+
+static bool writePacked(const std::string& path)
+{
+    FILE* file = fopen(path.c_str(), "wb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    fwrite(PACKED_MAGIC, 1, 4, file);
+    put16(file, panelSize);
+    put16(file, panelSize);
+    put32(file, STATES);
+
+    for (uint32_t index = 0; index < STATES; index++)
+    {
+        state_t state;
+        getState(index, &state);
+
+        fputc(state.hour, file);
+        fputc(state.minute, file);
+        fputc(state.day, file);
+        fputc(state.date, file);
+        fwrite(&frames[index * stride * panelSize], 1, stride * panelSize, file);
+    }
+
+    return (fclose(file) == 0);
+}
+
+int main(int argc, char* argv[])
+{
+    const char* format = "pbm";
+    const char* output = NULL;
+    int argument = 1;
+
+    threads = sysconf(_SC_NPROCESSORS_ONLN);
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if ((strcmp(argv[argument], "-j") == 0) && (argument + 1 < argc))
+        {
+            threads = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-p") == 0) && (argument + 1 < argc))
+        {
+            panelSize = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-f") == 0) && (argument + 1 < argc))
+        {
+            format = argv[++argument];
+        }
+        else if ((strcmp(argv[argument], "-o") == 0) && (argument + 1 < argc))
+        {
+            output = argv[++argument];
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    if ((argument != argc) || (threads == 0) || (panelSize == 0) ||
+        ((strcmp(format, "pbm") != 0) && (strcmp(format, "packed") != 0)))
+    {
+        fprintf(stderr, "usage: %s [-j <threads>] [-p <size>] [-f pbm|packed] [-o <output>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (threads > MAX_THREADS)
+    {
+        threads = MAX_THREADS;
+    }
+
+    stride = (panelSize + 7) / 8;
+    frames = new uint8_t[STATES * stride * panelSize];
+    memset(frames, 0, STATES * stride * panelSize);
+
+    /* equal shares to start with */
+    for (uint32_t index = 0; index < threads; index++)
+    {
+        pthread_mutex_init(&workers[index].lock, NULL);
+        workers[index].next = (STATES * index) / threads;
+        workers[index].end = (STATES * (index + 1)) / threads;
+        workers[index].frames = 0;
+        workers[index].steals = 0;
+        workers[index].cpuTime = 0;
+    }
+
+    pthread_t handles[MAX_THREADS];
+    double start = getTime(CLOCK_MONOTONIC);
+
+    for (uint32_t index = 0; index < threads; index++)
+    {
+        pthread_create(&handles[index], NULL, work, (void*) (size_t) index);
+    }
+
+    for (uint32_t index = 0; index < threads; index++)
+    {
+        pthread_join(handles[index], NULL);
+    }
+
+    double wall = getTime(CLOCK_MONOTONIC) - start;
+
+    printf("thread   frames  steals   fps/cpu\n");
+
+    for (uint32_t index = 0; index < threads; index++)
+    {
+        const worker_t& worker = workers[index];
+
+        printf("%6u %8u %7u %9.0f\n", index, worker.frames, worker.steals,
+               (worker.cpuTime > 0) ? worker.frames / worker.cpuTime : 0);
+    }
+
+    printf("%u frames of %ux%u on %u threads in %.3f s: %.0f fps, %.0f fps per core\n",
+           STATES, panelSize, panelSize, threads, wall, STATES / wall, STATES / wall / threads);
+
+    if (output)
+    {
+        bool written = (strcmp(format, "pbm") == 0) ? writePBM(output) : writePacked(output);
+
+        if (written == false)
+        {
+            fprintf(stderr, "%s: unable to write %s\n", argv[0], output);
+            return EXIT_FAILURE;
+        }
+    }
+
+    delete [] frames;
+
+    return EXIT_SUCCESS;
+}
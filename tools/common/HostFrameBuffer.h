@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __TOOLS_HOSTFRAMEBUFFER_H__
+#define __TOOLS_HOSTFRAMEBUFFER_H__
+
+#include "UIFramework/FrameBuffer.h"
+
+#include <stdint.h>
+
+/*  1 bpp canvas shared by the host tools, laid out like the display's frame
+    buffer: rows of stride bytes, most significant bit first, lit pixels set.
+    Windows from getFrameBuffer share the bits and are clipped to the parent.
+*/
+class HostFrameBuffer : public FrameBuffer
+{
+public:
+    HostFrameBuffer(uint8_t* _bits, uint16_t _stride, uint16_t _xOrigin, uint16_t _yOrigin,
+                    uint16_t _width, uint16_t _height)
+        :   bits(_bits),
+            stride(_stride),
+            xOrigin(_xOrigin),
+            yOrigin(_yOrigin),
+            width(_width),
+            height(_height)
+    {
+    }
+
+    virtual void drawPixel(uint16_t x, uint16_t y, uint8_t color)
+    {
+        if ((x < width) && (y < height))
+        {
+            uint8_t* byte = &bits[(yOrigin + y) * stride + (xOrigin + x) / 8];
+            uint8_t mask = 0x80 >> ((xOrigin + x) % 8);
+
+            *byte = (color) ? (*byte | mask) : (*byte & ~mask);
+        }
+    }
+
+    virtual uint8_t getPixel(uint16_t x, uint16_t y) const
+    {
+        if ((x < width) && (y < height))
+        {
+            uint8_t mask = 0x80 >> ((xOrigin + x) % 8);
+
+            return (bits[(yOrigin + y) * stride + (xOrigin + x) / 8] & mask) ? 1 : 0;
+        }
+
+        return 0;
+    }
+
+    virtual void drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color)
+    {
+        for (uint16_t y = y0; (y < y1) && (y < height); y++)
+        {
+            for (uint16_t x = x0; (x < x1) && (x < width); x++)
+            {
+                drawPixel(x, y, color);
+            }
+        }
+    }
+
+    virtual uint16_t getWidth(void) const
+    {
+        return width;
+    }
+
+    virtual uint16_t getHeight(void) const
+    {
+        return height;
+    }
+
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(int16_t x, int16_t y, uint16_t _width, uint16_t _height)
+    {
+        /* clip the window to this one */
+        int32_t x0 = (x > 0) ? x : 0;
+        int32_t y0 = (y > 0) ? y : 0;
+        int32_t x1 = ((x + _width) < width) ? (x + _width) : width;
+        int32_t y1 = ((y + _height) < height) ? (y + _height) : height;
+
+        x1 = (x1 > x0) ? x1 : x0;
+        y1 = (y1 > y0) ? y1 : y0;
+
+        return SharedPointer<FrameBuffer>(new HostFrameBuffer(bits, stride, xOrigin + x0, yOrigin + y0,
+                                                            x1 - x0, y1 - y0));
+    }
+
+private:
+    uint8_t* bits;
+    uint16_t stride;
+    uint16_t xOrigin;
+    uint16_t yOrigin;
+    uint16_t width;
+    uint16_t height;
+};
+
+#endif // __TOOLS_HOSTFRAMEBUFFER_H__
@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool estimating the energy the face uses per day.
+
+    Usage: energy [-d <days>] [-t <milliseconds>] [-a <start>,<end>,<interval>]
+                  [-s] [-r] [-x <scale>] [-e <unit>=<microjoules>]... [-q]
+
+    A 128x128 WatchFaceUI runs on a virtual clock from midnight for -d days
+    (1 by default), drawing every frame it asks for, and every frame is
+    counted in units that cost energy on target:
+
+    wakeup      every fillFrameBuffer call, since the device sleeps for
+                the delay each call returns
+    cpu         milliseconds spent in fillFrameBuffer, measured as host CPU
+                time and multiplied by -x (1 by default), the target's CPU
+                time per host CPU time found with facebench rolls
+    line        canvas rows that differ from the frame before, the unit a
+                memory LCD is updated in
+    pixel       canvas pixels that differ from the frame before
+    frame       animation frames, those returning a delay under a second
+
+    Every simulated day a line gives the counts and the energy they cost,
+    in millijoules, and a last line the average day. The cost of each unit
+    in microjoules is set with -e, e.g. -e line=0.8 -e cpu=12. The
+    defaults, wakeup=10, cpu=10, line=1, pixel=0 and frame=0, are rough
+    placeholders; use figures measured on the target when comparing.
+
+    The face is set up with:
+
+    -t  Minute roll duration, see WatchFaceUI::setTransitionTime.
+    -a  Ambient schedule, see WatchFaceUI::setAmbientSchedule.
+    -s  Show seconds.
+    -r  Retained canvas.
+
+    The frame limit is the frame profile the tool is built with, see
+    WATCH_FACE_FRAME_PROFILE, and is printed with the other settings so
+    tables from different builds and settings can be told apart. -q prints
+    only the settings and the average day, one line each, for collecting
+    many runs into one table.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, e.g.:
+    g++ -O2 -I. <dependency include paths> -o energy tools/energy/energy.cpp <module and dependency sources>
+*/
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "uif-ui-watch-face-wrd/WatchFaceFrameGovernor.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#define PANEL_SIZE 128
+#define STRIDE (PANEL_SIZE / 8)
+
+#define MILLISECONDS_PER_DAY (24UL * 60 * 60 * 1000)
+
+/*  Frames closer together than this are part of an animation, as in
+    tools/tracereplay.
+*/
+#define ANIMATION_DELAY_MS 1000
+
+#if WATCH_FACE_FRAME_PROFILE == WATCH_FACE_PROFILE_LOW_POWER
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_LOW_POWER
+#define FRAME_PROFILE_NAME "low power"
+#else
+#define FRAME_PROFILE WatchFaceFrameGovernor::PROFILE_SMOOTH
+#define FRAME_PROFILE_NAME "smooth"
+#endif
+
+typedef enum {
+    UNIT_WAKEUP,
+    UNIT_CPU,
+    UNIT_LINE,
+    UNIT_PIXEL,
+    UNIT_FRAME,
+    UNITS
+} unit_t;
+
+static const char* const unitNames[UNITS] = {
+    "wakeup",
+    "cpu",
+    "line",
+    "pixel",
+    "frame"
+};
+
+/* microjoules per unit */
+static double coefficients[UNITS] = { 10.0, 10.0, 1.0, 0.0, 0.0 };
+
+typedef struct {
+    double units[UNITS];
+} day_t;
+
+static uint32_t countBits(uint8_t byte)
+{
+    uint32_t count = 0;
+
+    for (; byte; byte &= byte - 1)
+    {
+        count++;
+    }
+
+    return count;
+}
+
+/*  Count the rows and pixels that changed, and remember the frame.
+*/
+static void compareFrame(const uint8_t* bits, uint8_t* previous, day_t* day)
+{
+    for (uint32_t row = 0; row < PANEL_SIZE; row++)
+    {
+        const uint8_t* line = &bits[row * STRIDE];
+        uint8_t* last = &previous[row * STRIDE];
+
+        if (memcmp(line, last, STRIDE) != 0)
+        {
+            day->units[UNIT_LINE]++;
+
+            for (uint32_t index = 0; index < STRIDE; index++)
+            {
+                day->units[UNIT_PIXEL] += countBits(line[index] ^ last[index]);
+            }
+
+            memcpy(last, line, STRIDE);
+        }
+    }
+}
+
+static double energy(const day_t& day, unit_t unit)
+{
+    /* microjoules to millijoules */
+    return day.units[unit] * coefficients[unit] / 1000.0;
+}
+
+static void printDay(const char* label, const day_t& day)
+{
+    double total = 0;
+
+    for (uint32_t unit = 0; unit < UNITS; unit++)
+    {
+        total += energy(day, (unit_t) unit);
+    }
+
+    printf("%5s %8.0f %6.0f %9.1f %8.0f %9.0f %9.2f %8.2f %8.2f %8.2f %9.2f\n",
+           label, day.units[UNIT_WAKEUP], day.units[UNIT_FRAME], day.units[UNIT_CPU],
+           day.units[UNIT_LINE], day.units[UNIT_PIXEL],
+           energy(day, UNIT_WAKEUP), energy(day, UNIT_CPU),
+           energy(day, UNIT_LINE) + energy(day, UNIT_PIXEL), energy(day, UNIT_FRAME), total);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t days = 1;
+    uint32_t transition = 0;
+    unsigned ambient[3] = { 0, 0, 0 };
+    bool ambientSchedule = false;
+    bool seconds = false;
+    bool retained = false;
+    bool quiet = false;
+    double scale = 1.0;
+    int argument = 1;
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if ((strcmp(argv[argument], "-d") == 0) && (argument + 1 < argc))
+        {
+            days = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-t") == 0) && (argument + 1 < argc))
+        {
+            transition = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-a") == 0) && (argument + 1 < argc))
+        {
+            if (sscanf(argv[++argument], "%u,%u,%u", &ambient[0], &ambient[1], &ambient[2]) != 3)
+            {
+                fprintf(stderr, "%s: -a takes <start>,<end>,<interval>\n", argv[0]);
+                return EXIT_FAILURE;
+            }
+
+            ambientSchedule = true;
+        }
+        else if (strcmp(argv[argument], "-s") == 0)
+        {
+            seconds = true;
+        }
+        else if (strcmp(argv[argument], "-r") == 0)
+        {
+            retained = true;
+        }
+        else if ((strcmp(argv[argument], "-x") == 0) && (argument + 1 < argc))
+        {
+            scale = atof(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-e") == 0) && (argument + 1 < argc))
+        {
+            const char* setting = argv[++argument];
+            const char* value = strchr(setting, '=');
+            uint32_t unit = 0;
+
+            while ((unit < UNITS) &&
+                   ((value == NULL) || (strlen(unitNames[unit]) != (size_t) (value - setting)) ||
+                    (strncmp(setting, unitNames[unit], value - setting) != 0)))
+            {
+                unit++;
+            }
+
+            if (unit == UNITS)
+            {
+                fprintf(stderr, "%s: -e takes <unit>=<microjoules>, unit one of "
+                                "wakeup, cpu, line, pixel, frame\n", argv[0]);
+                return EXIT_FAILURE;
+            }
+
+            coefficients[unit] = atof(value + 1);
+        }
+        else if (strcmp(argv[argument], "-q") == 0)
+        {
+            quiet = true;
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    if ((argument != argc) || (days == 0))
+    {
+        fprintf(stderr, "usage: %s [-d <days>] [-t <milliseconds>] [-a <start>,<end>,<interval>] "
+                        "[-s] [-r] [-x <scale>] [-e <unit>=<microjoules>]... [-q]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    static uint8_t bits[PANEL_SIZE * STRIDE];
+    static uint8_t previous[PANEL_SIZE * STRIDE];
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(bits, STRIDE, 0, 0, PANEL_SIZE, PANEL_SIZE));
+
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(0, 0, 0, 0, 1);
+
+    WatchFaceUI face(clock);
+    face.setWidth(PANEL_SIZE);
+    face.setHeight(PANEL_SIZE);
+
+    if (transition > 0)
+    {
+        face.setTransitionTime(transition);
+    }
+
+    if (ambientSchedule)
+    {
+        face.setAmbientSchedule(ambient[0], ambient[1], ambient[2]);
+    }
+
+    face.setSeconds(seconds);
+    face.setRetainedCanvas(retained);
+
+    printf("glyph packs %d, %s profile %u ms frames, transition %u ms, ambient ",
+           WATCH_FACE_GLYPH_PACK, FRAME_PROFILE_NAME, (unsigned) FRAME_PROFILE.minimumInterval,
+           (transition > 0) ? transition : 250);
+
+    if (ambientSchedule && (ambient[0] != ambient[1]))
+    {
+        printf("%u-%u every %u min", ambient[0], ambient[1], ambient[2]);
+    }
+    else
+    {
+        printf("off");
+    }
+
+    printf(", seconds %s, retained canvas %s, cpu x%.2f, uJ wakeup %g cpu %g line %g pixel %g frame %g\n",
+           (seconds) ? "on" : "off", (retained) ? "on" : "off", scale,
+           coefficients[UNIT_WAKEUP], coefficients[UNIT_CPU], coefficients[UNIT_LINE],
+           coefficients[UNIT_PIXEL], coefficients[UNIT_FRAME]);
+
+    if (quiet == false)
+    {
+        printf("  day  wakeups   anim    cpu ms    lines    pixels wakeup mJ   cpu mJ   lcd mJ  anim mJ  total mJ\n");
+    }
+
+    day_t day;
+    day_t sum;
+    memset(&day, 0, sizeof(day_t));
+    memset(&sum, 0, sizeof(day_t));
+
+    uint64_t end = (uint64_t) days * MILLISECONDS_PER_DAY;
+    uint64_t elapsed = 0;
+    uint64_t nextDay = MILLISECONDS_PER_DAY;
+    uint32_t dayIndex = 1;
+
+    while (elapsed < end)
+    {
+        clock_t start = std::clock();
+        uint32_t delay = face.fillFrameBuffer(canvas, 0, 0);
+        clock_t cpu = std::clock() - start;
+
+        day.units[UNIT_WAKEUP]++;
+        day.units[UNIT_CPU] += (1000.0 * cpu / CLOCKS_PER_SEC) * scale;
+
+        if (delay < ANIMATION_DELAY_MS)
+        {
+            day.units[UNIT_FRAME]++;
+        }
+
+        compareFrame(bits, previous, &day);
+
+        virtualClock->advance(delay);
+        elapsed += delay;
+
+        /* a frame counts towards the day it was drawn in */
+        if ((elapsed >= nextDay) || (elapsed >= end))
+        {
+            char label[12];
+            snprintf(label, sizeof(label), "%u", dayIndex);
+
+            if (quiet == false)
+            {
+                printDay(label, day);
+            }
+
+            for (uint32_t unit = 0; unit < UNITS; unit++)
+            {
+                sum.units[unit] += day.units[unit];
+            }
+
+            memset(&day, 0, sizeof(day_t));
+            nextDay += MILLISECONDS_PER_DAY;
+            dayIndex++;
+        }
+    }
+
+    for (uint32_t unit = 0; unit < UNITS; unit++)
+    {
+        sum.units[unit] /= days;
+    }
+
+    if (quiet)
+    {
+        printf("  day  wakeups   anim    cpu ms    lines    pixels wakeup mJ   cpu mJ   lcd mJ  anim mJ  total mJ\n");
+    }
+
+    printDay("avg", sum);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,505 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool measuring the face on a virtual clock.
+
+    Usage: facebench [-p <size>[,<size>...]] [-n <count>] [-a <start>,<end>,<interval>] <report>
+
+    Each report runs a WatchFaceUI on a WatchFaceVirtualClock, drawing every
+    frame it asks for into a host canvas, and prints what it measured. -p
+    lists the panel sizes to run it for, in pixels square,
+    WATCH_FACE_PANEL_WIDTH by default, e.g. -p 128,176,240. The Font_*
+    fonts are sized for 128, so build with glyph packs rendered for the
+    other sizes, see tools/glyphpack/packs.sh, to measure those.
+
+    ambient     One day from midnight, first without and then with the
+                ambient schedule given by -a (22,7,5 by default, see
+                WatchFaceUI::setAmbientSchedule). Prints the minute rolls,
+                rolls skipped, frames, ambient wakeups and per-minute
+                wakeups saved for both days.
+
+    midnight    From 10:58 to 11:01 and from 23:58 to 00:01, -n times (100
+                by default). Prints the host CPU time of the frame starting
+                each roll, and of the idle frames in the last minute of the
+                hour, which pre-stage the cells for the hour roll and, at
+                23:59, for the day and date. The midnight roll costs about
+                as much as the minute roll before it once pre-staged.
+
+    boot        -n boots (100 by default) at 10:00. Each constructs a face
+                and draws its first frame, then constructs one from a state
+                and snapshot saved from it, see WatchFaceSnapshot. Prints
+                the time to the first frame of both and of the frame after
+                the snapshot, which builds the face, and the snapshot size.
+
+    rolls       -n minutes (60 by default) from 23:00, so longer runs
+                include the day roll at midnight. Prints the minute rolls,
+                frames, animation frames, and the average and worst time
+                per frame.
+
+    seconds     -n seconds (600 by default) from 10:00:00 with the seconds
+                readout on a retained canvas, see WatchFaceUI::setSeconds.
+                Prints the ticks only redrawing the seconds and the full
+                frames, with the pixels drawn and the average time of each.
+
+    Times are host CPU time per frame in microseconds. They compare costs
+    within a run; use a target build for absolute figures.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, e.g.:
+    g++ -O2 -I. <dependency include paths> -o facebench tools/facebench/facebench.cpp <module and dependency sources>
+*/
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "uif-ui-watch-face-wrd/WatchFaceSnapshot.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <time.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#define MILLISECONDS_PER_DAY (24UL * 60 * 60 * 1000)
+
+/*  Frames closer together than this are part of an animation.
+*/
+#define ANIMATION_DELAY_MS 1000
+
+/*  Canvas of the panel size being measured.
+*/
+class Panel
+{
+public:
+    Panel(uint16_t size)
+        :   bits(((size + 7) / 8) * size, 0),
+            canvas(new HostFrameBuffer(&bits[0], (size + 7) / 8, 0, 0, size, size))
+    {
+    }
+
+    std::vector<uint8_t> bits;
+    SharedPointer<FrameBuffer> canvas;
+};
+
+#define MAX_SIZES 8
+
+static uint16_t panelSize = WATCH_FACE_PANEL_WIDTH;
+static uint32_t count = 0;
+
+static uint8_t ambientStart = 22;
+static uint8_t ambientEnd = 7;
+static uint8_t ambientInterval = 5;
+
+/*  Host CPU time in microseconds.
+*/
+static double getCpuTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &now);
+
+    return (now.tv_sec * 1e6) + (now.tv_nsec / 1e3);
+}
+
+/*  Runs a face through the given time, drawing every frame it asks for.
+*/
+static void run(WatchFaceUI& face, WatchFaceVirtualClock* clock, Panel& panel, uint32_t milliseconds)
+{
+    uint32_t elapsed = 0;
+
+    while (elapsed < milliseconds)
+    {
+        uint32_t delay = face.fillFrameBuffer(panel.canvas, 0, 0);
+
+        clock->advance(delay);
+        elapsed += delay;
+    }
+}
+
+static void reportAmbient(void)
+{
+    printf("schedule      rolls  skipped   frames  wakeups    saved\n");
+
+    for (uint32_t scheduled = 0; scheduled < 2; scheduled++)
+    {
+        Panel panel(panelSize);
+
+        WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+        SharedPointer<WatchFaceClock> clock(virtualClock);
+
+        virtualClock->set(0, 0, 0, 0, 1);
+
+        WatchFaceUI face(clock);
+        face.setWidth(panelSize);
+        face.setHeight(panelSize);
+
+        if (scheduled)
+        {
+            face.setAmbientSchedule(ambientStart, ambientEnd, ambientInterval);
+        }
+
+        run(face, virtualClock, panel, MILLISECONDS_PER_DAY);
+
+        const WatchFaceUI::statistics_t& statistics = face.getStatistics();
+        char schedule[16];
+
+        if (scheduled)
+        {
+            snprintf(schedule, sizeof(schedule), "%u-%u/%u", ambientStart, ambientEnd, ambientInterval);
+        }
+        else
+        {
+            snprintf(schedule, sizeof(schedule), "none");
+        }
+
+        printf("%-10s %8u %8u %8u %8u %8u\n", schedule,
+               statistics.animations, statistics.animationsSkipped, statistics.frames,
+               statistics.ambientWakeups, statistics.wakeupsSaved);
+    }
+}
+
+static void reportMidnight(void)
+{
+    /* per hour measured: minute roll, hour roll, idle frames at :59 */
+    static const uint8_t hours[] = { 10, 23 };
+    double rollTime[2][2] = { { 0, 0 }, { 0, 0 } };
+    double idleTime[2] = { 0, 0 };
+    uint32_t idleFrames[2] = { 0, 0 };
+
+    for (uint32_t run = 0; run < count; run++)
+    {
+        for (uint32_t index = 0; index < 2; index++)
+        {
+            Panel panel(panelSize);
+
+            WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+            SharedPointer<WatchFaceClock> clock(virtualClock);
+
+            virtualClock->set(hours[index], 58, 0, 0, 1);
+
+            WatchFaceUI face(clock);
+            face.setWidth(panelSize);
+            face.setHeight(panelSize);
+
+            uint32_t elapsed = 0;
+            uint32_t delay = 0;
+
+            while (elapsed < 3 * 60 * 1000)
+            {
+                uint8_t hour, minute, second;
+                virtualClock->getTime(&hour, &minute, &second);
+
+                bool animating = (delay > 0) && (delay < ANIMATION_DELAY_MS);
+                uint32_t animations = face.getStatistics().animations;
+
+                double start = getCpuTime();
+                delay = face.fillFrameBuffer(panel.canvas, 0, 0);
+                double time = getCpuTime() - start;
+
+                if (face.getStatistics().animations != animations)
+                {
+                    /* the roll to :59 or to :00 */
+                    rollTime[index][(minute == 59) ? 0 : 1] += time;
+                }
+                else if ((minute == 59) && !animating)
+                {
+                    idleTime[index] += time;
+                    idleFrames[index]++;
+                }
+
+                virtualClock->advance(delay);
+                elapsed += delay;
+            }
+        }
+    }
+
+    printf("frame                          us\n");
+
+    for (uint32_t index = 0; index < 2; index++)
+    {
+        uint8_t next = (hours[index] + 1) % 24;
+        char label[32];
+
+        snprintf(label, sizeof(label), "minute roll to %02u:59", hours[index]);
+        printf("%-24s %9.1f\n", label, rollTime[index][0] / count);
+
+        snprintf(label, sizeof(label), "%s roll to %02u:00", (next == 0) ? "day" : "hour", next);
+        printf("%-24s %9.1f\n", label, rollTime[index][1] / count);
+
+        snprintf(label, sizeof(label), "%u idle at %02u:59", idleFrames[index] / count, hours[index]);
+        printf("%-24s %9.1f\n", label, idleTime[index] / count);
+    }
+}
+
+static void reportBoot(void)
+{
+    Panel panel(panelSize);
+
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(10, 0, 0, 0, 1);
+
+    uint32_t size = WatchFaceSnapshot::getSize(panelSize, panelSize);
+    std::vector<uint8_t> snapshot(size);
+    watch_face_state_t state;
+
+    double coldTime = 0;
+    double snapshotTime = 0;
+    double buildTime = 0;
+
+    for (uint32_t run = 0; run < count; run++)
+    {
+        double start = getCpuTime();
+
+        WatchFaceUI* face = new WatchFaceUI(clock);
+        face->setWidth(panelSize);
+        face->setHeight(panelSize);
+        face->fillFrameBuffer(panel.canvas, 0, 0);
+
+        coldTime += getCpuTime() - start;
+
+        /* what the application persists before powering down */
+        face->saveState(&state);
+        WatchFaceSnapshot::capture(panel.canvas, &snapshot[0]);
+        delete face;
+
+        start = getCpuTime();
+
+        face = new WatchFaceUI(clock, &state, &snapshot[0]);
+        face->fillFrameBuffer(panel.canvas, 0, 0);
+
+        double shown = getCpuTime();
+        snapshotTime += shown - start;
+
+        face->fillFrameBuffer(panel.canvas, 0, 0);
+
+        buildTime += getCpuTime() - shown;
+
+        delete face;
+    }
+
+    printf("boot                     us\n");
+    printf("%-16s %9.1f\n", "constructor", coldTime / count);
+    printf("%-16s %9.1f\n", "snapshot", snapshotTime / count);
+    printf("%-16s %9.1f\n", "build", buildTime / count);
+    printf("snapshot %u bytes\n", size);
+}
+
+static void reportRolls(void)
+{
+    Panel panel(panelSize);
+
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(23, 0, 0, 0, 1);
+
+    WatchFaceUI face(clock);
+    face.setWidth(panelSize);
+    face.setHeight(panelSize);
+
+    uint32_t frames = 0;
+    uint32_t animationFrames = 0;
+    double time = 0;
+    double worstTime = 0;
+
+    uint32_t elapsed = 0;
+
+    while (elapsed < count * 60 * 1000)
+    {
+        double start = getCpuTime();
+        uint32_t delay = face.fillFrameBuffer(panel.canvas, 0, 0);
+        double frameTime = getCpuTime() - start;
+
+        frames++;
+        time += frameTime;
+
+        if (frameTime > worstTime)
+        {
+            worstTime = frameTime;
+        }
+
+        if (delay < ANIMATION_DELAY_MS)
+        {
+            animationFrames++;
+        }
+
+        /* moves the millisecond counter along with the time of day */
+        virtualClock->advance(delay);
+        elapsed += delay;
+    }
+
+    printf("rolls   frames animating  us/frame     worst\n");
+    printf("%5u %8u %9u %9.1f %9.1f\n", face.getStatistics().animations, frames,
+           animationFrames, time / frames, worstTime);
+}
+
+static void reportSeconds(void)
+{
+    Panel panel(panelSize);
+
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    virtualClock->set(10, 0, 0, 0, 1);
+
+    WatchFaceUI face(clock);
+    face.setWidth(panelSize);
+    face.setHeight(panelSize);
+    face.setRetainedCanvas(true);
+    face.setSeconds(true);
+
+    uint32_t ticks = 0;
+    uint32_t tickPixels = 0;
+    double tickTime = 0;
+    uint32_t frames = 0;
+    double frameTime = 0;
+
+    uint32_t elapsed = 0;
+
+    while (elapsed < count * 1000)
+    {
+        uint32_t partialFrames = face.getStatistics().partialFrames;
+
+        double start = getCpuTime();
+        uint32_t delay = face.fillFrameBuffer(panel.canvas, 0, 0);
+        double time = getCpuTime() - start;
+
+        watch_face_rect_t region;
+
+        /* a tick is a partial frame whose only damage is the readout */
+        if ((face.getStatistics().partialFrames != partialFrames) &&
+            face.getSecondsDamage(&region))
+        {
+            ticks++;
+            tickTime += time;
+            tickPixels = region.width * region.height;
+        }
+        else
+        {
+            frames++;
+            frameTime += time;
+        }
+
+        virtualClock->advance(delay);
+        elapsed += delay;
+    }
+
+    printf("frame    count   pixels  us/frame\n");
+    printf("tick  %8u %8u %9.1f\n", ticks, tickPixels, (ticks) ? tickTime / ticks : 0);
+    printf("full  %8u %8u %9.1f\n", frames, panelSize * panelSize, (frames) ? frameTime / frames : 0);
+}
+
+typedef struct {
+    const char* name;
+    void (*report)(void);
+    uint32_t count;     // default for -n
+} report_t;
+
+static const report_t reports[] = {
+    { "ambient",    reportAmbient,  0 },
+    { "boot",       reportBoot,     100 },
+    { "midnight",   reportMidnight, 100 },
+    { "rolls",      reportRolls,    60 },
+    { "seconds",    reportSeconds,  600 }
+};
+
+int main(int argc, char* argv[])
+{
+    uint16_t sizes[MAX_SIZES] = { WATCH_FACE_PANEL_WIDTH };
+    uint32_t sizeCount = 1;
+    int argument = 1;
+    bool valid = true;
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if ((strcmp(argv[argument], "-p") == 0) && (argument + 1 < argc))
+        {
+            char* list = argv[++argument];
+
+            for (sizeCount = 0; (sizeCount < MAX_SIZES) && (*list != '\0'); sizeCount++)
+            {
+                sizes[sizeCount] = strtoul(list, &list, 10);
+                valid = valid && (sizes[sizeCount] > 0) && ((*list == ',') || (*list == '\0'));
+                list += (*list == ',') ? 1 : 0;
+            }
+
+            valid = valid && (sizeCount > 0) && (*list == '\0');
+        }
+        else if ((strcmp(argv[argument], "-n") == 0) && (argument + 1 < argc))
+        {
+            count = atoi(argv[++argument]);
+            valid = valid && (count > 0);
+        }
+        else if ((strcmp(argv[argument], "-a") == 0) && (argument + 1 < argc))
+        {
+            unsigned start, end, interval;
+
+            if (sscanf(argv[++argument], "%u,%u,%u", &start, &end, &interval) != 3)
+            {
+                break;
+            }
+
+            ambientStart = start;
+            ambientEnd = end;
+            ambientInterval = interval;
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    for (size_t index = 0; valid && (argument + 1 == argc) &&
+                           (index < sizeof(reports) / sizeof(report_t)); index++)
+    {
+        if (strcmp(argv[argument], reports[index].name) == 0)
+        {
+            if (count == 0)
+            {
+                count = reports[index].count;
+            }
+
+            for (uint32_t size = 0; size < sizeCount; size++)
+            {
+                panelSize = sizes[size];
+
+                printf("%s%s, %ux%u\n", (size > 0) ? "\n" : "", reports[index].name,
+                       panelSize, panelSize);
+                reports[index].report();
+            }
+
+            return EXIT_SUCCESS;
+        }
+    }
+
+    fprintf(stderr, "usage: %s [-p <size>[,<size>...]] [-n <count>] [-a <start>,<end>,<interval>] <report>\n",
+            argv[0]);
+    fprintf(stderr, "reports:");
+
+    for (size_t index = 0; index < sizeof(reports) / sizeof(report_t); index++)
+    {
+        fprintf(stderr, " %s", reports[index].name);
+    }
+
+    fprintf(stderr, "\n");
+
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,658 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool generating a glyph pack source file.
+
+    Usage: glyphpack [-r] [-b] [-g <bits>] [-m <metrics>] <symbol> <pbm-directory> < labels.txt > <symbol>.cpp
+
+    labels.txt lists one label per line. Each label is read from
+    <pbm-directory>/<label>.pbm, rendered in the font the pack is for. Both
+    plain (P1) and raw (P4) PBM files are accepted. Black pixels are ink.
+
+    The emitted source defines `const glyph_pack_t <symbol>` with the index
+    sorted by label, as required by glyphPackFind.
+
+    -r  Run-length encode every glyph where that is smaller than the bitmap
+        and print the flash used by each glyph in both formats.
+    -b  Benchmark decoding every glyph in both formats through the same
+        glyphPackForEachRun used on target, filling runs into a word-based
+        1bpp buffer. On target each run is a drawRectangle call on the
+        display's canvas instead, which this does not measure.
+    -g  Read anti-aliased renders from <label>.pgm instead (P2 or P5, dark
+        pixels are ink) and store them as GLYPH_FORMAT_GRAY2 or
+        GLYPH_FORMAT_GRAY4 for <bits> 2 or 4. With -b, the blend kernels
+        of GlyphBlend.h are compared instead of the 1 bpp formats.
+    -m  Also define `const glyph_metrics_t <metrics>[]` with the width and
+        height of every label, in the order of labels.txt, so layout code
+        can look up a label by the value it shows without rendering it.
+
+    Build with: g++ -O2 -I. -o glyphpack tools/glyphpack/glyphpack.cpp
+*/
+
+#include "uif-ui-watch-face-wrd/GlyphBlend.h"
+#include "uif-ui-watch-face-wrd/GlyphPackFormat.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+struct Glyph
+{
+    std::string label;
+    unsigned width;
+    unsigned height;
+    std::vector<unsigned char> bits;    // rows padded to whole bytes, 1 bpp or gray
+    std::vector<unsigned char> runs;    // GLYPH_FORMAT_RLE encoding
+    glyph_format_t format;
+
+    const std::vector<unsigned char>& encoded() const
+    {
+        return (format == GLYPH_FORMAT_RLE) ? runs : bits;
+    }
+};
+
+static const char* formatName(glyph_format_t format)
+{
+    switch (format)
+    {
+        case GLYPH_FORMAT_RLE:
+            return "GLYPH_FORMAT_RLE";
+        case GLYPH_FORMAT_GRAY2:
+            return "GLYPH_FORMAT_GRAY2";
+        case GLYPH_FORMAT_GRAY4:
+            return "GLYPH_FORMAT_GRAY4";
+        case GLYPH_FORMAT_BITMAP:
+        default:
+            return "GLYPH_FORMAT_BITMAP";
+    }
+}
+
+static bool byLabel(const Glyph& a, const Glyph& b)
+{
+    return a.label < b.label;
+}
+
+static int readToken(FILE* file)
+{
+    int c = fgetc(file);
+
+    /* skip whitespace and comments */
+    while ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n') || (c == '#'))
+    {
+        if (c == '#')
+        {
+            while ((c != '\n') && (c != EOF))
+            {
+                c = fgetc(file);
+            }
+        }
+
+        c = fgetc(file);
+    }
+
+    return c;
+}
+
+static bool readNumber(FILE* file, unsigned* number)
+{
+    int c = readToken(file);
+
+    if ((c < '0') || (c > '9'))
+    {
+        return false;
+    }
+
+    *number = 0;
+
+    while ((c >= '0') && (c <= '9'))
+    {
+        *number = (*number * 10) + (c - '0');
+        c = fgetc(file);
+    }
+
+    return true;
+}
+
+static bool readPBM(const std::string& path, Glyph* glyph)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool result = false;
+
+    int p = fgetc(file);
+    int type = fgetc(file);
+
+    if ((p == 'P') && ((type == '1') || (type == '4')) &&
+        readNumber(file, &glyph->width) &&
+        readNumber(file, &glyph->height))
+    {
+        unsigned stride = (glyph->width + 7) / 8;
+
+        glyph->bits.assign(stride * glyph->height, 0);
+
+        if (type == '4')
+        {
+            /* raw PBM uses the same row layout as the pack */
+            result = fread(&glyph->bits[0], 1, glyph->bits.size(), file)
+                     == glyph->bits.size();
+        }
+        else
+        {
+            result = true;
+
+            for (unsigned y = 0; (y < glyph->height) && result; y++)
+            {
+                for (unsigned x = 0; (x < glyph->width) && result; x++)
+                {
+                    int c = readToken(file);
+
+                    if (c == '1')
+                    {
+                        glyph->bits[y * stride + x / 8] |= 0x80 >> (x % 8);
+                    }
+                    else if (c != '0')
+                    {
+                        result = false;
+                    }
+                }
+            }
+        }
+    }
+
+    fclose(file);
+
+    return result;
+}
+
+static bool readPGM(const std::string& path, unsigned grayBits, Glyph* glyph)
+{
+    FILE* file = fopen(path.c_str(), "rb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    bool result = false;
+    unsigned maximum = 0;
+
+    int p = fgetc(file);
+    int type = fgetc(file);
+
+    if ((p == 'P') && ((type == '2') || (type == '5')) &&
+        readNumber(file, &glyph->width) &&
+        readNumber(file, &glyph->height) &&
+        readNumber(file, &maximum) && (maximum > 0) && (maximum < 256))
+    {
+        unsigned stride = ((glyph->width * grayBits) + 7) / 8;
+        unsigned levels = (1 << grayBits) - 1;
+
+        glyph->bits.assign(stride * glyph->height, 0);
+
+        result = true;
+
+        for (unsigned y = 0; (y < glyph->height) && result; y++)
+        {
+            for (unsigned x = 0; (x < glyph->width) && result; x++)
+            {
+                unsigned value = 0;
+
+                if (type == '5')
+                {
+                    int c = fgetc(file);
+
+                    result = (c != EOF);
+                    value = c;
+                }
+                else
+                {
+                    result = readNumber(file, &value) && (value <= maximum);
+                }
+
+                /* dark is ink, quantized to the nearest coverage level */
+                unsigned coverage = (((maximum - value) * levels) + (maximum / 2)) / maximum;
+                unsigned bit = x * grayBits;
+
+                glyph->bits[y * stride + bit / 8] |= coverage << (8 - grayBits - (bit % 8));
+            }
+        }
+    }
+
+    fclose(file);
+
+    return result;
+}
+
+static void encodeRLE(Glyph* glyph)
+{
+    unsigned stride = (glyph->width + 7) / 8;
+
+    glyph->runs.clear();
+
+    for (unsigned y = 0; y < glyph->height; y++)
+    {
+        bool ink = false;
+        unsigned x = 0;
+
+        while (x < glyph->width)
+        {
+            unsigned length = 0;
+
+            while ((x + length < glyph->width) &&
+                   (((glyph->bits[y * stride + (x + length) / 8] >> (7 - (x + length) % 8)) & 1) == ink))
+            {
+                length++;
+            }
+
+            /* split long runs with an empty run of the other color */
+            while (length > 255)
+            {
+                glyph->runs.push_back(255);
+                glyph->runs.push_back(0);
+                length -= 255;
+                x += 255;
+            }
+
+            glyph->runs.push_back(length);
+            x += length;
+            ink = !ink;
+        }
+    }
+}
+
+/*  Word-based 1bpp destination, the same way a frame buffer fills
+    rectangles: whole 32-bit words inside the run, masks at the ends.
+*/
+class WordSink
+{
+public:
+    WordSink(unsigned _width, unsigned _height)
+        :   stride((_width + 31) / 32),
+            words(stride * _height, 0)
+    {
+    }
+
+    void ink(int32_t x0, int32_t x1, int32_t y)
+    {
+        uint32_t* row = &words[y * stride];
+        int32_t first = x0 / 32;
+        int32_t last = (x1 - 1) / 32;
+        uint32_t head = 0xFFFFFFFFUL >> (x0 % 32);
+        uint32_t tail = 0xFFFFFFFFUL << (31 - ((x1 - 1) % 32));
+
+        if (first == last)
+        {
+            row[first] |= head & tail;
+        }
+        else
+        {
+            row[first] |= head;
+
+            for (int32_t word = first + 1; word < last; word++)
+            {
+                row[word] = 0xFFFFFFFFUL;
+            }
+
+            row[last] |= tail;
+        }
+    }
+
+    void clear()
+    {
+        std::fill(words.begin(), words.end(), 0);
+    }
+
+private:
+    unsigned stride;
+    std::vector<uint32_t> words;
+};
+
+static double benchmark(const Glyph& glyph, glyph_format_t format)
+{
+    const std::vector<unsigned char>& data = (format == GLYPH_FORMAT_RLE) ? glyph.runs : glyph.bits;
+
+    glyph_pack_entry_t entry = { glyph.label.c_str(), 0,
+                                 (uint16_t) glyph.width, (uint16_t) glyph.height,
+                                 (uint8_t) format };
+    glyph_pack_t pack = { 1, &entry, &data[0] };
+
+    WordSink sink(glyph.width, glyph.height);
+    const unsigned iterations = 2000;
+
+    clock_t start = clock();
+
+    for (unsigned iteration = 0; iteration < iterations; iteration++)
+    {
+        sink.clear();
+        glyphPackForEachRun(&pack, &entry, 0, 0, glyph.width, glyph.height, sink);
+    }
+
+    return ((double) (clock() - start) * 1e9) / CLOCKS_PER_SEC / iterations;
+}
+
+/*  Blends coverage rows into an 8-bit gray buffer with the given kernel.
+*/
+typedef void (*blend_kernel_t)(uint8_t*, const uint8_t*, uint32_t, uint8_t);
+
+class BlendSink
+{
+public:
+    BlendSink(unsigned _width, unsigned _height, blend_kernel_t _kernel)
+        :   width(_width),
+            levels(_width * _height, 0),
+            kernel(_kernel)
+    {
+    }
+
+    void coverage(int32_t x, int32_t y, const uint8_t* values, int32_t count)
+    {
+        kernel(&levels[y * width + x], values, count, 255);
+    }
+
+    void clear()
+    {
+        std::fill(levels.begin(), levels.end(), 0);
+    }
+
+private:
+    unsigned width;
+    std::vector<uint8_t> levels;
+    blend_kernel_t kernel;
+};
+
+static double benchmarkGray(const Glyph& glyph, blend_kernel_t kernel)
+{
+    glyph_pack_entry_t entry = { glyph.label.c_str(), 0,
+                                 (uint16_t) glyph.width, (uint16_t) glyph.height,
+                                 (uint8_t) glyph.format };
+    glyph_pack_t pack = { 1, &entry, &glyph.bits[0] };
+
+    BlendSink sink(glyph.width, glyph.height, kernel);
+    const unsigned iterations = 2000;
+
+    clock_t start = clock();
+
+    for (unsigned iteration = 0; iteration < iterations; iteration++)
+    {
+        sink.clear();
+        glyphPackForEachSpan(&pack, &entry, 0, 0, glyph.width, glyph.height, sink);
+    }
+
+    return ((double) (clock() - start) * 1e9) / CLOCKS_PER_SEC / iterations;
+}
+
+/*  The fastest kernel the compiler offers, and its name in the report.
+*/
+#if defined(__SSE2__)
+#define VECTOR_KERNEL glyphBlendSSE2
+#define VECTOR_NAME "sse2 ns"
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define VECTOR_KERNEL glyphBlendNEON
+#define VECTOR_NAME "neon ns"
+#else
+#define VECTOR_KERNEL glyphBlendScalar
+#define VECTOR_NAME "scalar ns"
+#endif
+
+int main(int argc, char* argv[])
+{
+    bool rle = false;
+    bool bench = false;
+    std::string metrics;
+    unsigned grayBits = 0;
+    int argument = 1;
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if (strcmp(argv[argument], "-r") == 0)
+        {
+            rle = true;
+        }
+        else if (strcmp(argv[argument], "-b") == 0)
+        {
+            bench = true;
+        }
+        else if ((strcmp(argv[argument], "-g") == 0) && (argument + 1 < argc))
+        {
+            grayBits = atoi(argv[++argument]);
+
+            if ((grayBits != 2) && (grayBits != 4))
+            {
+                fprintf(stderr, "%s: -g takes 2 or 4\n", argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if ((strcmp(argv[argument], "-m") == 0) && (argument + 1 < argc))
+        {
+            metrics = argv[++argument];
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    if (argc - argument != 2)
+    {
+        fprintf(stderr, "usage: %s [-r] [-b] [-g <bits>] [-m <metrics>] <symbol> <pbm-directory> < labels.txt\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::string symbol(argv[argument]);
+    std::string directory(argv[argument + 1]);
+    std::vector<Glyph> glyphs;
+
+    char line[256];
+
+    while (fgets(line, sizeof(line), stdin))
+    {
+        std::string label(line);
+
+        while (!label.empty() &&
+               ((label[label.size() - 1] == '\n') || (label[label.size() - 1] == '\r')))
+        {
+            label.erase(label.size() - 1);
+        }
+
+        if (label.empty())
+        {
+            continue;
+        }
+
+        Glyph glyph;
+        glyph.label = label;
+        glyph.format = GLYPH_FORMAT_BITMAP;
+
+        if (grayBits)
+        {
+            if (!readPGM(directory + "/" + label + ".pgm", grayBits, &glyph))
+            {
+                fprintf(stderr, "%s: unable to read %s/%s.pgm\n",
+                        argv[0], directory.c_str(), label.c_str());
+                return EXIT_FAILURE;
+            }
+
+            glyph.format = (grayBits == 4) ? GLYPH_FORMAT_GRAY4 : GLYPH_FORMAT_GRAY2;
+        }
+        else
+        {
+            if (!readPBM(directory + "/" + label + ".pbm", &glyph))
+            {
+                fprintf(stderr, "%s: unable to read %s/%s.pbm\n",
+                        argv[0], directory.c_str(), label.c_str());
+                return EXIT_FAILURE;
+            }
+
+            encodeRLE(&glyph);
+
+            if (rle && (glyph.runs.size() < glyph.bits.size()))
+            {
+                glyph.format = GLYPH_FORMAT_RLE;
+            }
+        }
+
+        glyphs.push_back(glyph);
+    }
+
+    /* metrics keep the order of the labels file */
+    std::vector<Glyph> ordered(glyphs);
+
+    std::sort(glyphs.begin(), glyphs.end(), byLabel);
+
+    if (grayBits && bench)
+    {
+        fprintf(stderr, "%-12s %8s %12s %12s\n", "label", "bytes", "scalar ns", VECTOR_NAME);
+
+        for (size_t index = 0; index < glyphs.size(); index++)
+        {
+            const Glyph& glyph = glyphs[index];
+
+            fprintf(stderr, "%-12s %8u %12.0f %12.0f\n",
+                    glyph.label.c_str(),
+                    (unsigned) glyph.bits.size(),
+                    benchmarkGray(glyph, glyphBlendScalar),
+                    benchmarkGray(glyph, VECTOR_KERNEL));
+        }
+    }
+    else if (rle || bench)
+    {
+        unsigned long bitmapTotal = 0;
+        unsigned long packTotal = 0;
+
+        fprintf(stderr, "%-12s %8s %8s %8s", "label", "bitmap", "rle", "saved");
+
+        if (bench)
+        {
+            fprintf(stderr, " %12s %12s", "bitmap ns", "rle ns");
+        }
+
+        fprintf(stderr, "\n");
+
+        for (size_t index = 0; index < glyphs.size(); index++)
+        {
+            const Glyph& glyph = glyphs[index];
+            long saved = (long) glyph.bits.size() - (long) glyph.encoded().size();
+
+            fprintf(stderr, "%-12s %8u %8u %8ld",
+                    glyph.label.c_str(),
+                    (unsigned) glyph.bits.size(),
+                    (unsigned) glyph.runs.size(),
+                    saved);
+
+            if (bench)
+            {
+                fprintf(stderr, " %12.0f %12.0f",
+                        benchmark(glyph, GLYPH_FORMAT_BITMAP),
+                        benchmark(glyph, GLYPH_FORMAT_RLE));
+            }
+
+            fprintf(stderr, "\n");
+
+            bitmapTotal += glyph.bits.size();
+            packTotal += glyph.encoded().size();
+        }
+
+        fprintf(stderr, "%-12s %8lu %8s %8ld\n", "total", bitmapTotal, "",
+                (long) bitmapTotal - (long) packTotal);
+    }
+
+    printf("/* Generated by tools/glyphpack. Do not edit. */\n\n");
+    printf("#include \"uif-ui-watch-face-wrd/GlyphPack.h\"\n\n");
+
+    /* bitmap data */
+    printf("static const uint8_t %s_data[] = {\n", symbol.c_str());
+
+    unsigned long offset = 0;
+    std::vector<unsigned long> offsets;
+
+    for (size_t index = 0; index < glyphs.size(); index++)
+    {
+        const Glyph& glyph = glyphs[index];
+
+        offsets.push_back(offset);
+        printf("    /* %s */\n   ", glyph.label.c_str());
+
+        const std::vector<unsigned char>& bytes = glyph.encoded();
+
+        for (size_t byte = 0; byte < bytes.size(); byte++)
+        {
+            printf(" 0x%02X,", bytes[byte]);
+
+            if (((byte % 12) == 11) && (byte + 1 < bytes.size()))
+            {
+                printf("\n   ");
+            }
+        }
+
+        printf("\n");
+        offset += bytes.size();
+    }
+
+    printf("};\n\n");
+
+    /* index */
+    printf("static const glyph_pack_entry_t %s_index[] = {\n", symbol.c_str());
+
+    for (size_t index = 0; index < glyphs.size(); index++)
+    {
+        printf("    { \"%s\", %lu, %u, %u, %s },\n",
+               glyphs[index].label.c_str(),
+               offsets[index],
+               glyphs[index].width,
+               glyphs[index].height,
+               formatName(glyphs[index].format));
+    }
+
+    printf("};\n\n");
+
+    printf("const glyph_pack_t %s = {\n", symbol.c_str());
+    printf("    %u,\n", (unsigned) glyphs.size());
+    printf("    %s_index,\n", symbol.c_str());
+    printf("    %s_data\n", symbol.c_str());
+    printf("};\n");
+
+    if (!metrics.empty())
+    {
+        printf("\nconst glyph_metrics_t %s[%u] = {\n", metrics.c_str(), (unsigned) ordered.size());
+
+        for (size_t index = 0; index < ordered.size(); index++)
+        {
+            printf("    { %u, %u }, /* %s */\n",
+                   ordered[index].width,
+                   ordered[index].height,
+                   ordered[index].label.c_str());
+        }
+
+        printf("};\n");
+    }
+
+    fprintf(stderr, "%s: %u glyphs, %lu bytes of bitmap data\n",
+            symbol.c_str(), (unsigned) glyphs.size(), offset);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#!/bin/sh
+#
+# Copyright (c) 2016, ARM Limited, All Rights Reserved
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License"); you may
+# not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+# WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# Generate the glyph pack sources for one panel size.
+#
+# Usage: tools/glyphpack/packs.sh <panel> <pbm-root> [output-directory]
+#
+# <pbm-root>/<panel> holds one directory per font, Hours, Minutes, Dayndate
+# and Menu, with every label of tools/glyphpack/<font>.txt rendered for the
+# panel, e.g. pbm/176/Minutes/7.pbm. Dayndate also holds the digits 0-9 for
+# the seconds, see tools/glyphpack/Seconds.txt. The sources are written to
+# output-directory, source/ by default. Build with WATCH_FACE_PANEL_WIDTH and
+# WATCH_FACE_PANEL_HEIGHT set to the same panel.
+#
+# tools/labelrender renders the labels for the 128x128 panel from the Font_*
+# fonts into <pbm-root>/128. Larger panels need renders from fonts of their
+# size.
+
+set -e
+
+if [ $# -lt 2 ]; then
+    echo "usage: $0 <panel> <pbm-root> [output-directory]" >&2
+    exit 1
+fi
+
+panel=$1
+root=$2/$panel
+output=${3:-source}
+tools=$(dirname "$0")
+glyphpack=${TMPDIR:-/tmp}/glyphpack.$$
+
+trap 'rm -f "$glyphpack"' EXIT
+
+g++ -O2 -I"$tools/../.." -o "$glyphpack" "$tools/glyphpack.cpp"
+
+"$glyphpack" -m GlyphMetrics_Hours GlyphPack_Hours "$root/Hours" \
+    < "$tools/Hours.txt" > "$output/GlyphPack_Hours.cpp"
+"$glyphpack" -r -m GlyphMetrics_Minutes GlyphPack_Minutes "$root/Minutes" \
+    < "$tools/Minutes.txt" > "$output/GlyphPack_Minutes.cpp"
+"$glyphpack" -m GlyphMetrics_Dayndate GlyphPack_Dayndate "$root/Dayndate" \
+    < "$tools/Dayndate.txt" > "$output/GlyphPack_Dayndate.cpp"
+"$glyphpack" GlyphPack_Seconds "$root/Dayndate" \
+    < "$tools/Seconds.txt" > "$output/GlyphPack_Seconds.cpp"
+"$glyphpack" GlyphPack_Menu "$root/Menu" \
+    < "$tools/Menu.txt" > "$output/GlyphPack_Menu.cpp"
@@ -0,0 +1,695 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool simulating months of heap use by the face and menu tables.
+
+    Usage: heapsim [-d <days>] [-m <sessions>] [-H <bytes>] [-i <days>] [-r <seed>]
+                   [-b <baseline>] [-w <baseline>] [-t <bytes>]
+
+    Every operator new and delete made during the simulation is served from
+    a model of the target's heap instead of the host's: an arena of -H
+    bytes (32768 by default) handed out first fit from the lowest address
+    in 8 byte aligned chunks with an 8 byte header, splitting chunks and
+    merging free neighbours like newlib's malloc. The highest chunk in use
+    marks the extent of the heap, like the break of an sbrk heap, and
+    freeing the top chunk lowers it. Requests the arena cannot satisfy are
+    counted as failures and served by the host so the run can go on.
+
+    A 128x128 WatchFaceUI runs on a virtual clock for -d days (30 by
+    default), drawing every frame it asks for. On average -m menu sessions
+    a day (4 by default) start at random times, hiding the face while one
+    of the Set*MenuTable classes is scrolled through a few random flings,
+    with views taken from viewAtIndex as rows come into view and released
+    as they leave, as UITableView does. -r seeds the random sessions (1 by
+    default), so runs are repeatable.
+
+    Every -i days (1 by default) a line reports the bytes in use, headers
+    included, and their peak, the extent and its peak, the free chunks below
+    the extent, the largest free block, fragmentation as
+    1 - largest free block / free bytes, and the allocations and failures
+    so far.
+
+    -b  Compare the peak use and peak extent with those recorded in
+        <baseline> and exit with status 2 if either has grown by more than
+        -t bytes (0 by default). Meant for CI with a short run, e.g.
+        heapsim -d 1 -b heapsim-baseline.txt. The exit status is 2 as well
+        when any allocation failed.
+    -w  Record the peak use and peak extent in <baseline>.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, e.g.:
+    g++ -O2 -I. <dependency include paths> -o heapsim tools/heapsim/heapsim.cpp <module and dependency sources>
+*/
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/SetDateMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetHourMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetMinuteMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetMonthMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetTimeMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetYearMenuTable.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#define PANEL_SIZE 128
+
+#define HEAP_ALIGN 8
+#define HEAP_HEADER 8
+#define HEAP_MINIMUM_CHUNK 16
+#define CHUNK_FREE 1
+
+#define MILLISECONDS_PER_DAY (24UL * 60 * 60 * 1000)
+
+/* menu sessions */
+#define MENU_TABLES 6
+#define MENU_FRAME_MS 40
+#define MENU_MAX_FLINGS 8
+#define MENU_MAX_FLING_ROWS 12
+#define MENU_MIN_SPEED 4
+#define MENU_MAX_SPEED 40
+#define MENU_VISIBLE_ROWS 8
+
+/*****************************************************************************/
+/* Heap model                                                                */
+/*****************************************************************************/
+
+typedef struct {
+    uint32_t size;          // chunk bytes including the header, CHUNK_FREE when free
+    uint32_t previousSize;  // bytes in the chunk below, 0 for the first
+} chunk_t;
+
+typedef struct {
+    uint32_t used;          // bytes in allocated chunks, headers included
+    uint32_t peakUsed;
+    uint32_t extent;        // bytes from the start of the arena to the top chunk's end
+    uint32_t peakExtent;
+    uint32_t freeChunks;    // free chunks below the extent
+    uint32_t largestFree;   // largest free chunk, or the space above the extent
+    uint32_t allocations;
+    uint32_t failures;      // requests the arena could not satisfy
+} heap_statistics_t;
+
+class HeapModel
+{
+public:
+    HeapModel(uint32_t _capacity)
+        :   capacity(_capacity & ~(HEAP_ALIGN - 1)),
+            extent(0),
+            top(0),
+            used(0),
+            peakUsed(0),
+            peakExtent(0),
+            allocations(0),
+            failures(0)
+    {
+        /* the host's malloc, operator new would come back here */
+        arena = (uint8_t*) malloc(capacity);
+    }
+
+    void* allocate(size_t size)
+    {
+        if (size > capacity)
+        {
+            failures++;
+            return NULL;
+        }
+
+        uint32_t need = (size + HEAP_HEADER + HEAP_ALIGN - 1) & ~(HEAP_ALIGN - 1);
+
+        if (need < HEAP_MINIMUM_CHUNK)
+        {
+            need = HEAP_MINIMUM_CHUNK;
+        }
+
+        /* first fit among the free chunks below the extent */
+        uint32_t offset = 0;
+
+        while (offset < extent)
+        {
+            chunk_t* chunk = at(offset);
+
+            if ((chunk->size & CHUNK_FREE) && (chunk->size - CHUNK_FREE >= need))
+            {
+                split(offset, need);
+                chunk->size &= ~CHUNK_FREE;
+
+                return take(offset);
+            }
+
+            offset += chunk->size & ~CHUNK_FREE;
+        }
+
+        /* then grow the extent */
+        if (capacity - extent < need)
+        {
+            failures++;
+            return NULL;
+        }
+
+        chunk_t* chunk = at(extent);
+        chunk->size = need;
+        chunk->previousSize = (extent > 0) ? extent - top : 0;
+
+        top = extent;
+        extent += need;
+
+        if (extent > peakExtent)
+        {
+            peakExtent = extent;
+        }
+
+        return take(top);
+    }
+
+    /**
+     * @return False if the pointer is not from the arena.
+     */
+    bool release(void* pointer)
+    {
+        uint8_t* bytes = (uint8_t*) pointer;
+
+        if ((bytes < arena) || (bytes >= arena + capacity))
+        {
+            return false;
+        }
+
+        uint32_t offset = (bytes - arena) - HEAP_HEADER;
+        chunk_t* chunk = at(offset);
+        uint32_t size = chunk->size;
+
+        used -= size;
+
+        /* merge with the free chunks above and below */
+        if (offset + size < extent)
+        {
+            chunk_t* next = at(offset + size);
+
+            if (next->size & CHUNK_FREE)
+            {
+                size += next->size - CHUNK_FREE;
+            }
+        }
+
+        if ((offset > 0) && (at(offset - chunk->previousSize)->size & CHUNK_FREE))
+        {
+            offset -= chunk->previousSize;
+            size += at(offset)->size - CHUNK_FREE;
+        }
+
+        chunk = at(offset);
+
+        if (offset + size == extent)
+        {
+            /* the top chunk is handed back, lowering the extent */
+            extent = offset;
+            top = offset - chunk->previousSize;
+        }
+        else
+        {
+            chunk->size = size | CHUNK_FREE;
+            at(offset + size)->previousSize = size;
+        }
+
+        return true;
+    }
+
+    void getStatistics(heap_statistics_t* statistics) const
+    {
+        statistics->used = used;
+        statistics->peakUsed = peakUsed;
+        statistics->extent = extent;
+        statistics->peakExtent = peakExtent;
+        statistics->freeChunks = 0;
+        statistics->largestFree = capacity - extent;
+        statistics->allocations = allocations;
+        statistics->failures = failures;
+
+        for (uint32_t offset = 0; offset < extent; offset += at(offset)->size & ~CHUNK_FREE)
+        {
+            const chunk_t* chunk = at(offset);
+
+            if (chunk->size & CHUNK_FREE)
+            {
+                statistics->freeChunks++;
+
+                if (chunk->size - CHUNK_FREE > statistics->largestFree)
+                {
+                    statistics->largestFree = chunk->size - CHUNK_FREE;
+                }
+            }
+        }
+    }
+
+    uint32_t getCapacity(void) const
+    {
+        return capacity;
+    }
+
+private:
+    chunk_t* at(uint32_t offset) const
+    {
+        return (chunk_t*) &arena[offset];
+    }
+
+    /* leave need bytes in the free chunk at offset, the rest as a new free chunk */
+    void split(uint32_t offset, uint32_t need)
+    {
+        chunk_t* chunk = at(offset);
+        uint32_t size = chunk->size - CHUNK_FREE;
+
+        if (size - need >= HEAP_MINIMUM_CHUNK)
+        {
+            chunk->size = need | CHUNK_FREE;
+
+            chunk_t* rest = at(offset + need);
+            rest->size = (size - need) | CHUNK_FREE;
+            rest->previousSize = need;
+
+            /* free chunks never reach the extent, so there is a next one */
+            at(offset + size)->previousSize = size - need;
+        }
+    }
+
+    void* take(uint32_t offset)
+    {
+        used += at(offset)->size;
+        allocations++;
+
+        if (used > peakUsed)
+        {
+            peakUsed = used;
+        }
+
+        return &arena[offset + HEAP_HEADER];
+    }
+
+    uint8_t* arena;
+    uint32_t capacity;
+    uint32_t extent;
+    uint32_t top;           // offset of the chunk ending at the extent
+    uint32_t used;
+    uint32_t peakUsed;
+    uint32_t peakExtent;
+    uint32_t allocations;
+    uint32_t failures;
+};
+
+/*  Allocations are only taken from the model while active, but anything it
+    handed out is given back to it whenever deleted.
+*/
+static HeapModel* heap = NULL;
+static bool heapActive = false;
+
+void* operator new(size_t size)
+{
+    void* pointer = (heapActive) ? heap->allocate(size) : NULL;
+
+    if (pointer == NULL)
+    {
+        pointer = malloc((size > 0) ? size : 1);
+
+        if (pointer == NULL)
+        {
+            throw std::bad_alloc();
+        }
+    }
+
+    return pointer;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* pointer) throw()
+{
+    if (pointer && ((heap == NULL) || (heap->release(pointer) == false)))
+    {
+        free(pointer);
+    }
+}
+
+void operator delete[](void* pointer) throw()
+{
+    operator delete(pointer);
+}
+
+/*****************************************************************************/
+/* Simulation                                                                */
+/*****************************************************************************/
+
+/*  Park-Miller generator, the same sequence on every host.
+*/
+static uint32_t randomState = 1;
+
+static uint32_t nextRandom(uint32_t range)
+{
+    randomState = (uint32_t) (((uint64_t) randomState * 48271) % 2147483647);
+
+    return randomState % range;
+}
+
+static MenuTable* createTable(uint32_t index)
+{
+    switch (index)
+    {
+        case 0:
+            return new SetTimeMenuTable();
+        case 1:
+            return new SetHourMenuTable();
+        case 2:
+            return new SetMinuteMenuTable();
+        case 3:
+            return new SetDateMenuTable();
+        case 4:
+            return new SetMonthMenuTable();
+        case 5:
+        default:
+            return new SetYearMenuTable();
+    }
+}
+
+/*  Draw the rows visible at the offset, keeping the views of rows that stay
+    in view and taking new ones from viewAtIndex for the rest.
+*/
+static void drawRows(SharedPointer<UIView::Array>& table, SharedPointer<FrameBuffer>& canvas,
+                     uint32_t offset, SharedPointer<UIView>* views, uint32_t* rows, uint32_t* count)
+{
+    SharedPointer<UIView> visible[MENU_VISIBLE_ROWS];
+    uint32_t visibleRows[MENU_VISIBLE_ROWS];
+    uint32_t visibleCount = 0;
+
+    canvas->drawRectangle(0, canvas->getWidth(), 0, canvas->getHeight(), 0);
+
+    int32_t top = 0;
+
+    for (uint32_t index = 0; (index < table->getSize()) && (top < (int32_t) (offset + canvas->getHeight())); index++)
+    {
+        uint32_t height = table->heightAtIndex(index);
+
+        if ((top + (int32_t) height > (int32_t) offset) && (visibleCount < MENU_VISIBLE_ROWS))
+        {
+            SharedPointer<UIView> view;
+
+            for (uint32_t kept = 0; kept < *count; kept++)
+            {
+                if (rows[kept] == index)
+                {
+                    view = views[kept];
+                }
+            }
+
+            if (!view)
+            {
+                view = table->viewAtIndex(index);
+                view->setWidth(table->widthAtIndex(index));
+                view->setHeight(height);
+            }
+
+            /* rows above the viewport are clipped through the camera offset */
+            int32_t y = top - (int32_t) offset;
+            int32_t clip = (y < 0) ? y : 0;
+            int32_t shown = (int32_t) height + clip;
+
+            if (y - clip + shown > (int32_t) canvas->getHeight())
+            {
+                shown = canvas->getHeight() - (y - clip);
+            }
+
+            SharedPointer<FrameBuffer> row = canvas->getFrameBuffer(0, y - clip, canvas->getWidth(), shown);
+            view->fillFrameBuffer(row, 0, clip);
+
+            visible[visibleCount] = view;
+            visibleRows[visibleCount] = index;
+            visibleCount++;
+        }
+
+        top += height;
+    }
+
+    /* views of rows that left the viewport are released here */
+    for (uint32_t index = 0; index < MENU_VISIBLE_ROWS; index++)
+    {
+        views[index] = visible[index];
+        rows[index] = visibleRows[index];
+    }
+
+    *count = visibleCount;
+}
+
+/*  One visit to a menu: open a table at its default row, fling it around a
+    few times and close it.
+    @return Milliseconds spent in the menu.
+*/
+static uint32_t runSession(SharedPointer<FrameBuffer>& canvas)
+{
+    SharedPointer<UIView::Array> table(createTable(nextRandom(MENU_TABLES)));
+
+    uint32_t total = 0;
+    uint32_t offset = 0;
+
+    for (uint32_t index = 0; index < table->getSize(); index++)
+    {
+        if (index == table->getDefaultIndex())
+        {
+            offset = total;
+        }
+
+        total += table->heightAtIndex(index);
+    }
+
+    uint32_t range = (total > canvas->getHeight()) ? total - canvas->getHeight() : 0;
+    offset = (offset > range) ? range : offset;
+
+    SharedPointer<UIView> views[MENU_VISIBLE_ROWS];
+    uint32_t rows[MENU_VISIBLE_ROWS];
+    uint32_t count = 0;
+    uint32_t elapsed = 0;
+
+    drawRows(table, canvas, offset, views, rows, &count);
+
+    uint32_t flings = 1 + nextRandom(MENU_MAX_FLINGS);
+
+    for (uint32_t fling = 0; fling < flings; fling++)
+    {
+        int32_t distance = (1 + nextRandom(MENU_MAX_FLING_ROWS)) * WATCH_FACE_MENU_ROW_HEIGHT;
+        int32_t speed = MENU_MIN_SPEED + nextRandom(MENU_MAX_SPEED - MENU_MIN_SPEED + 1);
+
+        if (nextRandom(2))
+        {
+            distance = -distance;
+            speed = -speed;
+        }
+
+        for (int32_t moved = 0; moved != distance; )
+        {
+            moved = ((distance - moved) / speed > 0) ? moved + speed : distance;
+
+            int32_t position = (int32_t) offset + moved;
+            position = (position < 0) ? 0 : position;
+            position = (position > (int32_t) range) ? range : position;
+
+            drawRows(table, canvas, position, views, rows, &count);
+            elapsed += MENU_FRAME_MS;
+        }
+
+        offset += distance;
+        offset = ((int32_t) offset < 0) ? 0 : offset;
+        offset = (offset > range) ? range : offset;
+    }
+
+    return elapsed;
+}
+
+static void report(uint32_t day)
+{
+    heap_statistics_t statistics;
+    heap->getStatistics(&statistics);
+
+    uint32_t free = heap->getCapacity() - statistics.used;
+    double fragmentation = (free > 0) ? 1.0 - ((double) statistics.largestFree / free) : 0.0;
+
+    printf("%5u %7u %7u %7u %7u %6u %8u %5.1f%% %10u %6u\n",
+           day, statistics.used, statistics.peakUsed, statistics.extent, statistics.peakExtent,
+           statistics.freeChunks, statistics.largestFree, fragmentation * 100.0,
+           statistics.allocations, statistics.failures);
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t days = 30;
+    uint32_t sessions = 4;
+    uint32_t capacity = 32768;
+    uint32_t interval = 1;
+    uint32_t tolerance = 0;
+    const char* baseline = NULL;
+    const char* record = NULL;
+    int argument = 1;
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if ((strcmp(argv[argument], "-d") == 0) && (argument + 1 < argc))
+        {
+            days = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-m") == 0) && (argument + 1 < argc))
+        {
+            sessions = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-H") == 0) && (argument + 1 < argc))
+        {
+            capacity = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-i") == 0) && (argument + 1 < argc))
+        {
+            interval = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-r") == 0) && (argument + 1 < argc))
+        {
+            randomState = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-b") == 0) && (argument + 1 < argc))
+        {
+            baseline = argv[++argument];
+        }
+        else if ((strcmp(argv[argument], "-w") == 0) && (argument + 1 < argc))
+        {
+            record = argv[++argument];
+        }
+        else if ((strcmp(argv[argument], "-t") == 0) && (argument + 1 < argc))
+        {
+            tolerance = atoi(argv[++argument]);
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    if ((argument != argc) || (capacity < HEAP_MINIMUM_CHUNK) || (interval == 0) ||
+        (randomState % 2147483647 == 0))
+    {
+        fprintf(stderr, "usage: %s [-d <days>] [-m <sessions>] [-H <bytes>] [-i <days>] [-r <seed>] "
+                        "[-b <baseline>] [-w <baseline>] [-t <bytes>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /* the display's frame buffer is not on the heap */
+    static uint8_t bits[PANEL_SIZE * PANEL_SIZE / 8];
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(bits, PANEL_SIZE / 8, 0, 0,
+                                                          PANEL_SIZE, PANEL_SIZE));
+
+    heap = new HeapModel(capacity);
+    heapActive = true;
+
+    WatchFaceVirtualClock* virtualClock = new WatchFaceVirtualClock();
+    SharedPointer<WatchFaceClock> clock(virtualClock);
+
+    WatchFaceUI* face = new WatchFaceUI(clock);
+    face->setWidth(PANEL_SIZE);
+    face->setHeight(PANEL_SIZE);
+
+    printf("  day    used    peak  extent peakext  holes  largest  frag     allocs failed\n");
+
+    uint64_t end = (uint64_t) days * MILLISECONDS_PER_DAY;
+    uint64_t elapsed = 0;
+    uint64_t nextSession = (sessions > 0) ? nextRandom(2 * MILLISECONDS_PER_DAY / sessions) : end;
+    uint64_t nextReport = (uint64_t) interval * MILLISECONDS_PER_DAY;
+
+    while (elapsed < end)
+    {
+        uint32_t delay;
+
+        if (elapsed >= nextSession)
+        {
+            face->setVisible(false);
+            delay = runSession(canvas);
+            face->setVisible(true);
+
+            /* on average the given number of sessions a day */
+            nextSession += 1 + nextRandom(2 * MILLISECONDS_PER_DAY / sessions);
+        }
+        else
+        {
+            delay = face->fillFrameBuffer(canvas, 0, 0);
+        }
+
+        virtualClock->advance(delay);
+        elapsed += delay;
+
+        while ((elapsed >= nextReport) && (nextReport <= end))
+        {
+            report(nextReport / MILLISECONDS_PER_DAY);
+            nextReport += (uint64_t) interval * MILLISECONDS_PER_DAY;
+        }
+    }
+
+    delete face;
+    clock = SharedPointer<WatchFaceClock>();
+    heapActive = false;
+
+    heap_statistics_t statistics;
+    heap->getStatistics(&statistics);
+
+    printf("peak use %u bytes, peak extent %u bytes, %u failed allocations, %u bytes left in use\n",
+           statistics.peakUsed, statistics.peakExtent, statistics.failures, statistics.used);
+
+    if (record)
+    {
+        FILE* file = fopen(record, "w");
+
+        if ((file == NULL) ||
+            (fprintf(file, "%u %u\n", statistics.peakUsed, statistics.peakExtent) < 0) ||
+            (fclose(file) != 0))
+        {
+            fprintf(stderr, "%s: cannot write %s\n", argv[0], record);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (baseline)
+    {
+        FILE* file = fopen(baseline, "r");
+        unsigned peakUsed;
+        unsigned peakExtent;
+
+        if ((file == NULL) || (fscanf(file, "%u %u", &peakUsed, &peakExtent) != 2))
+        {
+            fprintf(stderr, "%s: cannot read %s\n", argv[0], baseline);
+            return EXIT_FAILURE;
+        }
+
+        fclose(file);
+
+        if ((statistics.peakUsed > peakUsed + tolerance) ||
+            (statistics.peakExtent > peakExtent + tolerance))
+        {
+            fprintf(stderr, "%s: peak use %u/%u bytes exceeds baseline %u/%u\n", argv[0],
+                    statistics.peakUsed, statistics.peakExtent, peakUsed, peakExtent);
+            return 2;
+        }
+    }
+
+    return (statistics.failures > 0) ? 2 : EXIT_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool rendering the glyph pack labels from the Font_* fonts.
+
+    Usage: labelrender <labels-directory> <pbm-root>
+
+    Every label listed in <labels-directory>/<font>.txt, normally
+    tools/glyphpack, is drawn by a UITextView in the font it is shown in and
+    written to <pbm-root>/128/<font>/<label>.pbm, the layout expected by
+    tools/glyphpack/packs.sh:
+
+    Hours.txt       Font_Hours      <pbm-root>/128/Hours
+    Minutes.txt     Font_Minutes    <pbm-root>/128/Minutes
+    Dayndate.txt    Font_Dayndate   <pbm-root>/128/Dayndate
+    Seconds.txt     Font_Dayndate   <pbm-root>/128/Dayndate
+    Menu.txt        Font_Menu       <pbm-root>/128/Menu
+
+    The labels are drawn inverted, as the face and menus draw them, and the
+    pixels UITextView sets are written black, which glyphpack reads as ink.
+    The fonts are sized for the 128x128 reference panel, so this produces
+    the packs for that panel:
+
+    labelrender tools/glyphpack pbm && tools/glyphpack/packs.sh 128 pbm
+
+    Build together with a host build of the UIFramework dependency, e.g.:
+    g++ -O2 -I. <dependency include paths> -o labelrender tools/labelrender/labelrender.cpp <dependency sources>
+*/
+
+#include "UIFramework/UITextView.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#define PANEL "128"
+
+typedef struct {
+    const char* labels;
+    const char* directory;
+    const FontData* font;
+} font_t;
+
+static const font_t fonts[] = {
+    { "Hours",      "Hours",    &Font_Hours },
+    { "Minutes",    "Minutes",  &Font_Minutes },
+    { "Dayndate",   "Dayndate", &Font_Dayndate },
+    { "Seconds",    "Dayndate", &Font_Dayndate },
+    { "Menu",       "Menu",     &Font_Menu }
+};
+
+static bool makeDirectory(const std::string& path)
+{
+    return (mkdir(path.c_str(), 0755) == 0) || (errno == EEXIST);
+}
+
+static bool renderLabel(const std::string& label, const FontData* font, const std::string& path)
+{
+    /* same as the face's cells, see createCell in WatchFaceUI.cpp */
+    UITextView cell(label.c_str(), font);
+    cell.prefetch(0, 0);
+    cell.setInverse(true);
+
+    uint16_t width = cell.getWidth();
+    uint16_t height = cell.getHeight();
+    uint16_t stride = (width + 7) / 8;
+
+    std::vector<uint8_t> bits(stride * height + 1, 0);
+
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(&bits[0], stride, 0, 0, width, height));
+
+    cell.fillFrameBuffer(canvas, 0, 0);
+
+    FILE* file = fopen(path.c_str(), "wb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    /* raw PBM has the same row layout as the canvas, set bits are black */
+    fprintf(file, "P4\n%u %u\n", width, height);
+    fwrite(&bits[0], 1, stride * height, file);
+
+    return (fclose(file) == 0);
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "usage: %s <labels-directory> <pbm-root>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    std::string labels = argv[1];
+    std::string root = std::string(argv[2]) + "/" + PANEL;
+
+    if (!makeDirectory(argv[2]) || !makeDirectory(root))
+    {
+        fprintf(stderr, "%s: unable to create %s\n", argv[0], root.c_str());
+        return EXIT_FAILURE;
+    }
+
+    for (size_t index = 0; index < sizeof(fonts) / sizeof(font_t); index++)
+    {
+        const font_t& font = fonts[index];
+        std::string path = labels + "/" + font.labels + ".txt";
+        std::string directory = root + "/" + font.directory;
+
+        FILE* file = fopen(path.c_str(), "r");
+
+        if (file == NULL)
+        {
+            fprintf(stderr, "%s: unable to read %s\n", argv[0], path.c_str());
+            return EXIT_FAILURE;
+        }
+
+        if (!makeDirectory(directory))
+        {
+            fprintf(stderr, "%s: unable to create %s\n", argv[0], directory.c_str());
+            return EXIT_FAILURE;
+        }
+
+        char line[64];
+        uint32_t count = 0;
+
+        while (fgets(line, sizeof(line), file))
+        {
+            std::string label(line, strcspn(line, "\r\n"));
+
+            if (label.empty())
+            {
+                continue;
+            }
+
+            if (!renderLabel(label, font.font, directory + "/" + label + ".pbm"))
+            {
+                fprintf(stderr, "%s: unable to write %s/%s.pbm\n", argv[0],
+                        directory.c_str(), label.c_str());
+                return EXIT_FAILURE;
+            }
+
+            count++;
+        }
+
+        fclose(file);
+
+        printf("%-8s %3u labels to %s\n", font.labels, count, directory.c_str());
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool reporting the MenuTable statistics while flicking through the
+    Set<something>MenuTable pickers.
+
+    Usage: menubench [-s <pixels>] [-f <flicks>]
+
+    Every table is flicked -f times (2 by default) from its top to its
+    bottom and back, -s pixels per frame (16 by default), through a
+    viewport the size of the panel. Each table runs twice, starting from an
+    empty MenuLabelCache: once drawing the rows with
+    MenuTable::fillVisibleRows alone, and once through a MenuTableView,
+    which spends the idle part of every frame on MenuTable::prefetchRows.
+    Prints MenuTable::getStatistics for both runs, and the labels evicted
+    from the cache:
+
+    table     run        frames dropped   hits misses prefetched stops evicted
+
+    With prefetching, labels scrolling into view are found in the cache,
+    so misses move from the frames to the idle time. Hits, misses and
+    prefetched rows are 0 without a label cache, i.e. with
+    WATCH_FACE_GLYPH_PACK or WATCH_FACE_MENU_LABEL_CACHE set to 0.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, e.g.:
+    g++ -O2 -I. <dependency include paths> -o menubench tools/menubench/menubench.cpp <module and dependency sources>
+*/
+
+#include "uif-ui-watch-face-wrd/MenuTableView.h"
+#include "uif-ui-watch-face-wrd/MenuLabel.h"
+#include "uif-ui-watch-face-wrd/SetTimeMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetHourMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetMinuteMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetDateMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetMonthMenuTable.h"
+#include "uif-ui-watch-face-wrd/SetYearMenuTable.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef struct {
+    const char* name;
+    MenuTable* (*create)(void);
+} table_t;
+
+static MenuTable* createTime(void)   { return new SetTimeMenuTable(); }
+static MenuTable* createHour(void)   { return new SetHourMenuTable(); }
+static MenuTable* createMinute(void) { return new SetMinuteMenuTable(); }
+static MenuTable* createDate(void)   { return new SetDateMenuTable(); }
+static MenuTable* createMonth(void)  { return new SetMonthMenuTable(); }
+static MenuTable* createYear(void)   { return new SetYearMenuTable(); }
+
+static const table_t tables[] = {
+    { "time",   createTime },
+    { "hour",   createHour },
+    { "minute", createMinute },
+    { "date",   createDate },
+    { "month",  createMonth },
+    { "year",   createYear }
+};
+
+static uint32_t speed = 16;
+static uint32_t flicks = 2;
+
+/*  Total height of a table, as UITableView sums it.
+*/
+static uint32_t getTableHeight(MenuTable& table)
+{
+    uint32_t height = 0;
+
+    for (uint32_t index = 0; index < table.getSize(); index++)
+    {
+        height += table.heightAtIndex(index);
+    }
+
+    return height;
+}
+
+/*  Flicks through the table, drawing one frame per step of the scroll.
+*/
+static void flick(const table_t& entry, bool prefetch)
+{
+    uint16_t stride = (WATCH_FACE_PANEL_WIDTH + 7) / 8;
+    std::vector<uint8_t> bits(stride * WATCH_FACE_PANEL_HEIGHT, 0);
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(&bits[0], stride, 0, 0,
+                                                          WATCH_FACE_PANEL_WIDTH,
+                                                          WATCH_FACE_PANEL_HEIGHT));
+
+#if MENU_LABEL_CACHE
+    MenuLabelCache::clear();
+    uint32_t evictions = MenuLabelCache::getStatistics().evictions;
+#else
+    uint32_t evictions = 0;
+#endif
+
+    SharedPointer<MenuTable> table(entry.create());
+    MenuTableView view(table);
+
+    uint32_t bottom = getTableHeight(*table) - WATCH_FACE_PANEL_HEIGHT;
+
+    for (uint32_t count = 0; count < 2 * flicks; count++)
+    {
+        bool down = ((count % 2) == 0);
+
+        for (uint32_t step = 0; step <= bottom; step += speed)
+        {
+            uint32_t offset = (down) ? step : bottom - step;
+
+            if (prefetch)
+            {
+                view.setScrollOffset(offset);
+                view.fillFrameBuffer(canvas, 0, 0);
+            }
+            else
+            {
+                table->fillVisibleRows(canvas, offset);
+            }
+        }
+    }
+
+#if MENU_LABEL_CACHE
+    evictions = MenuLabelCache::getStatistics().evictions - evictions;
+#endif
+
+    const MenuTable::statistics_t& statistics = table->getStatistics();
+
+    printf("%-9s %-9s %7u %7u %6u %6u %10u %5u %7u\n", entry.name, (prefetch) ? "prefetch" : "drawn",
+           statistics.frames, statistics.droppedFrames, statistics.hits, statistics.misses,
+           statistics.prefetched, statistics.budgetStops, evictions);
+}
+
+int main(int argc, char* argv[])
+{
+    int argument = 1;
+    bool valid = true;
+
+    while (valid && (argument + 1 < argc))
+    {
+        if (strcmp(argv[argument], "-s") == 0)
+        {
+            speed = atoi(argv[argument + 1]);
+            valid = (speed > 0);
+        }
+        else if (strcmp(argv[argument], "-f") == 0)
+        {
+            flicks = atoi(argv[argument + 1]);
+            valid = (flicks > 0);
+        }
+        else
+        {
+            valid = false;
+        }
+
+        argument += 2;
+    }
+
+    if (!valid || (argument != argc))
+    {
+        fprintf(stderr, "usage: %s [-s <pixels>] [-f <flicks>]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    printf("table     run        frames dropped   hits misses prefetched stops evicted\n");
+
+    for (size_t index = 0; index < sizeof(tables) / sizeof(table_t); index++)
+    {
+        flick(tables[index], false);
+        flick(tables[index], true);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,365 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*  Host tool replaying frame traces through a host build of the face.
+
+    Usage: tracereplay [-p <size>] <trace>
+           tracereplay -w <minutes> [-c <milliseconds>] [-p <size>] <trace>
+
+    A trace is written by WatchFaceTraceFile, on target or with -w. Replay
+    builds a face on a virtual clock set to the first frame, then for every
+    frame sets the clock to the recorded calendar snapshot and timestamp and
+    calls fillFrameBuffer with the recorded offsets, after setting the
+    recorded modes (ambient, seconds, row scroll, retained canvas, hidden)
+    that changed since the previous frame. Other settings, such as the
+    ambient schedule and the easing, are the face's defaults. Boot frames,
+    a cold started face showing its snapshot, are only counted and the
+    replay starts at the first frame after them. The face reads the
+    clock's milliseconds twice per frame, see
+    WatchFaceUI::setTraceRecorder: the first read returns the timestamp and
+    later reads return timestamp + renderTime. The frame governor, the
+    remaining time of the minute roll and the frame-budget watchdog thereby
+    see the frame costs measured when the trace was recorded.
+
+    Prints the number of frames and boot frames, the frames whose canvas
+    hash or returned delay differ from the recording, the first of them,
+    the longest run of sub-second delays, the slowest frame on the host and
+    the face's and governor's statistics. Exits with status 2 on any
+    mismatch.
+
+    -p  Panel size in pixels, WATCH_FACE_PANEL_WIDTH by default. Must match
+        the canvas the trace was recorded on.
+    -w  Record instead: run a face for <minutes> from 23:00 on a virtual
+        clock and write the trace, e.g. to replay it against another build.
+    -c  With -w, the milliseconds every frame takes on the virtual clock,
+        0 by default. Costs above the frame budget make the watchdog cut
+        the minute rolls short, which a replay has to reproduce.
+
+    Build together with the module's sources and a host build of its
+    UIFramework and mbed-time dependencies, e.g.:
+    g++ -O2 -I. <dependency include paths> -o tracereplay tools/tracereplay/tracereplay.cpp <module and dependency sources>
+*/
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+#include "uif-ui-watch-face-wrd/WatchFaceTrace.h"
+#include "tools/common/HostFrameBuffer.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+/*  Frames closer together than this are considered part of an animation.
+*/
+#define ANIMATION_DELAY_MS 1000
+
+/*  Virtual clock whose millisecond counter reads as the start of the frame
+    the first time in a frame, and cost milliseconds later from then on.
+*/
+class FrameClock : public WatchFaceVirtualClock
+{
+public:
+    FrameClock()
+        :   WatchFaceVirtualClock(),
+            cost(0),
+            reads(0)
+    {
+    }
+
+    /**
+     * @brief Start a frame taking the given time.
+     */
+    void startFrame(uint32_t _cost)
+    {
+        cost = _cost;
+        reads = 0;
+    }
+
+    virtual uint32_t getTimeInMilliseconds(void)
+    {
+        uint32_t now = WatchFaceVirtualClock::getTimeInMilliseconds();
+
+        return (reads++ == 0) ? now : now + cost;
+    }
+
+private:
+    uint32_t cost;
+    uint32_t reads;
+};
+
+static void printStatistics(WatchFaceUI& face)
+{
+    const WatchFaceUI::statistics_t& statistics = face.getStatistics();
+    const WatchFaceFrameGovernor::statistics_t& governor = face.getFrameStatistics();
+
+    printf("minute rolls       %8u\n", statistics.animations);
+    printf("rolls snapped      %8u\n", statistics.animationsSnapped);
+    printf("governed frames    %8u\n", governor.frames);
+    printf("governor overruns  %8u\n", governor.overruns);
+    printf("shortest interval  %8u ms\n", governor.shortestInterval);
+    printf("longest interval   %8u ms\n", governor.longestInterval);
+}
+
+/*  Set the modes that differ from the ones already set on the face. The
+    setters are only called on a change, as on the device, since some of
+    them force the next frame to be drawn in full.
+*/
+static void setModes(WatchFaceUI& face, uint8_t modes, uint8_t previous)
+{
+    uint8_t changed = modes ^ previous;
+
+    if (changed & WATCH_FACE_FRAME_AMBIENT)
+    {
+        face.setAmbient(modes & WATCH_FACE_FRAME_AMBIENT);
+    }
+
+    if (changed & WATCH_FACE_FRAME_SECONDS)
+    {
+        face.setSeconds(modes & WATCH_FACE_FRAME_SECONDS);
+    }
+
+    if (changed & WATCH_FACE_FRAME_ROW_SCROLL)
+    {
+        face.setRowScroll(modes & WATCH_FACE_FRAME_ROW_SCROLL);
+    }
+
+    if (changed & WATCH_FACE_FRAME_RETAINED_CANVAS)
+    {
+        face.setRetainedCanvas(modes & WATCH_FACE_FRAME_RETAINED_CANVAS);
+    }
+
+    if (changed & WATCH_FACE_FRAME_HIDDEN)
+    {
+        face.setVisible((modes & WATCH_FACE_FRAME_HIDDEN) == 0);
+    }
+}
+
+static int record(const char* path, uint16_t size, uint32_t minutes, uint32_t cost)
+{
+    FILE* file = fopen(path, "wb");
+
+    if (file == NULL)
+    {
+        fprintf(stderr, "unable to write %s\n", path);
+        return EXIT_FAILURE;
+    }
+
+    uint16_t stride = (size + 7) / 8;
+    std::vector<uint8_t> bits(stride * size, 0);
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(&bits[0], stride, 0, 0, size, size));
+
+    FrameClock* frameClock = new FrameClock();
+    SharedPointer<WatchFaceClock> clock(frameClock);
+
+    frameClock->set(23, 0, 0, 0, 1);
+
+    WatchFaceTraceFile trace(file);
+    WatchFaceUI face(clock);
+    face.setWidth(size);
+    face.setHeight(size);
+    face.setTraceRecorder(&trace);
+
+    uint32_t elapsed = 0;
+    uint32_t end = minutes * 60 * 1000;
+
+    while (elapsed < end)
+    {
+        frameClock->startFrame(cost);
+
+        uint32_t delay = face.fillFrameBuffer(canvas, 0, 0);
+
+        /* the next frame starts delay milliseconds after this one ended */
+        frameClock->advance(cost + delay);
+        elapsed += cost + delay;
+    }
+
+    printf("frames             %8u\n", face.getStatistics().frames);
+    printStatistics(face);
+
+    return (fclose(file) == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+static int replay(const char* path, uint16_t size)
+{
+    FILE* file = fopen(path, "rb");
+
+    if ((file == NULL) || !WatchFaceTraceFile::readHeader(file))
+    {
+        fprintf(stderr, "%s is not a trace\n", path);
+        return EXIT_FAILURE;
+    }
+
+    watch_face_frame_t frame;
+    uint32_t bootFrames = 0;
+    bool more = WatchFaceTraceFile::read(file, &frame);
+
+    /*  The snapshot a cold started face showed is not in the trace. The
+        face built on the frame after it is the same as one constructed
+        at that frame, so replay starts there.
+    */
+    while (more && (frame.modes & WATCH_FACE_FRAME_BOOT))
+    {
+        bootFrames++;
+        more = WatchFaceTraceFile::read(file, &frame);
+    }
+
+    if (more == false)
+    {
+        fclose(file);
+        printf("frames             %8u\n", bootFrames);
+        printf("boot frames        %8u\n", bootFrames);
+        return EXIT_SUCCESS;
+    }
+
+    uint16_t stride = (size + 7) / 8;
+    std::vector<uint8_t> bits(stride * size, 0);
+    SharedPointer<FrameBuffer> canvas(new HostFrameBuffer(&bits[0], stride, 0, 0, size, size));
+
+    /*  The face picks up its initial state from the clock when constructed,
+        so set the clock to the first frame before creating it.
+    */
+    FrameClock* frameClock = new FrameClock();
+    SharedPointer<WatchFaceClock> clock(frameClock);
+
+    frameClock->set(frame.time.hour, frame.time.minute, frame.time.second,
+                    frame.time.day, frame.time.date);
+    frameClock->setTimeInMilliseconds(frame.timestamp);
+
+    WatchFaceUI face(clock);
+    face.setWidth(size);
+    face.setHeight(size);
+
+    uint8_t modes = 0;
+    uint32_t frames = 0;
+    uint32_t hashMismatches = 0;
+    uint32_t delayMismatches = 0;
+    int32_t firstMismatch = -1;
+    uint32_t slowestFrame = 0;
+    uint32_t animation = 0;
+    uint32_t longestAnimation = 0;
+
+    do
+    {
+        frameClock->set(frame.time.hour, frame.time.minute, frame.time.second,
+                        frame.time.day, frame.time.date);
+        frameClock->setTimeInMilliseconds(frame.timestamp);
+        frameClock->startFrame(frame.renderTime);
+
+        setModes(face, frame.modes, modes);
+        modes = frame.modes;
+
+        uint32_t start = UIView::getTimeInMilliseconds();
+        uint32_t delay = face.fillFrameBuffer(canvas, frame.xOffset, frame.yOffset);
+        uint32_t hostTime = UIView::getTimeInMilliseconds() - start;
+
+        bool mismatch = false;
+
+        if (WatchFaceTrace::hash(canvas) != frame.hash)
+        {
+            hashMismatches++;
+            mismatch = true;
+        }
+
+        if (delay != frame.delay)
+        {
+            delayMismatches++;
+            mismatch = true;
+        }
+
+        if (mismatch && (firstMismatch < 0))
+        {
+            firstMismatch = frames;
+        }
+
+        if (hostTime > slowestFrame)
+        {
+            slowestFrame = hostTime;
+        }
+
+        /*  A run of short delays is an animation. One that never ends shows
+            up as a run as long as the trace.
+        */
+        animation = (delay < ANIMATION_DELAY_MS) ? animation + 1 : 0;
+
+        if (animation > longestAnimation)
+        {
+            longestAnimation = animation;
+        }
+
+        frames++;
+
+    } while (WatchFaceTraceFile::read(file, &frame));
+
+    fclose(file);
+
+    printf("frames             %8u\n", bootFrames + frames);
+    printf("boot frames        %8u\n", bootFrames);
+    printf("hash mismatches    %8u\n", hashMismatches);
+    printf("delay mismatches   %8u\n", delayMismatches);
+    printf("first mismatch     %8d\n", firstMismatch);
+    printf("longest animation  %8u frames\n", longestAnimation);
+    printf("slowest host frame %8u ms\n", slowestFrame);
+    printStatistics(face);
+
+    return (firstMismatch < 0) ? EXIT_SUCCESS : 2;
+}
+
+int main(int argc, char* argv[])
+{
+    uint16_t size = WATCH_FACE_PANEL_WIDTH;
+    uint32_t minutes = 0;
+    uint32_t cost = 0;
+    int argument = 1;
+
+    while ((argument < argc) && (argv[argument][0] == '-'))
+    {
+        if ((strcmp(argv[argument], "-p") == 0) && (argument + 1 < argc))
+        {
+            size = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-w") == 0) && (argument + 1 < argc))
+        {
+            minutes = atoi(argv[++argument]);
+        }
+        else if ((strcmp(argv[argument], "-c") == 0) && (argument + 1 < argc))
+        {
+            cost = atoi(argv[++argument]);
+        }
+        else
+        {
+            break;
+        }
+
+        argument++;
+    }
+
+    if ((argument + 1 != argc) || (size == 0))
+    {
+        fprintf(stderr, "usage: %s [-p <size>] <trace>\n"
+                        "       %s -w <minutes> [-c <milliseconds>] [-p <size>] <trace>\n",
+                argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    if (minutes)
+    {
+        return record(argv[argument], size, minutes, cost);
+    }
+
+    return replay(argv[argument], size);
+}
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_GLYPHBLEND_H__
+#define __UIF_UI_GLYPHBLEND_H__
+
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+/*  Kernels blending anti-aliased glyph coverage into 8-bit gray levels,
+    0 being black and 255 white:
+
+        dst = round((dst * (255 - coverage) + level * coverage) / 255)
+
+    The division uses (t + (t >> 8)) >> 8 with t = x + 128, exact for every
+    product of two bytes, so the vector kernels match the scalar one bit for
+    bit. Like GlyphPackFormat.h this header only depends on <stdint.h> and
+    the compiler's intrinsics, so the host tools can benchmark the kernels.
+*/
+
+/**
+ * @brief Blend one pixel.
+ *
+ * @param dst Gray level of the pixel.
+ * @param alpha Coverage of the pixel, 0-255.
+ * @param level Gray level of the ink.
+ * @return Blended gray level.
+ */
+static inline uint8_t glyphBlendPixel(uint32_t dst, uint32_t alpha, uint8_t level)
+{
+    uint32_t t = (dst * (255 - alpha)) + (level * alpha) + 128;
+
+    return (t + (t >> 8)) >> 8;
+}
+
+/**
+ * @brief Blend a span of coverage values, one pixel at a time.
+ *
+ * @param dst Gray levels, blended in place.
+ * @param coverage Coverage of each pixel, 0-255.
+ * @param count Number of pixels.
+ * @param level Gray level of the ink.
+ */
+static inline void glyphBlendScalar(uint8_t* dst, const uint8_t* coverage, uint32_t count, uint8_t level)
+{
+    for (uint32_t index = 0; index < count; index++)
+    {
+        dst[index] = glyphBlendPixel(dst[index], coverage[index], level);
+    }
+}
+
+#if defined(__SSE2__)
+/**
+ * @brief SSE2 version of glyphBlendScalar, 16 pixels at a time.
+ */
+static inline void glyphBlendSSE2(uint8_t* dst, const uint8_t* coverage, uint32_t count, uint8_t level)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i ink = _mm_set1_epi16(level);
+
+    uint32_t index = 0;
+
+    for (; index + 16 <= count; index += 16)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i*) &dst[index]);
+        __m128i c = _mm_loadu_si128((const __m128i*) &coverage[index]);
+
+        __m128i dLow = _mm_unpacklo_epi8(d, zero);
+        __m128i dHigh = _mm_unpackhi_epi8(d, zero);
+        __m128i cLow = _mm_unpacklo_epi8(c, zero);
+        __m128i cHigh = _mm_unpackhi_epi8(c, zero);
+
+        /* products of two bytes fit the unsigned 16-bit lanes */
+        __m128i tLow = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(dLow, _mm_sub_epi16(full, cLow)),
+                                                   _mm_mullo_epi16(ink, cLow)),
+                                     half);
+        __m128i tHigh = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(dHigh, _mm_sub_epi16(full, cHigh)),
+                                                    _mm_mullo_epi16(ink, cHigh)),
+                                      half);
+
+        tLow = _mm_srli_epi16(_mm_add_epi16(tLow, _mm_srli_epi16(tLow, 8)), 8);
+        tHigh = _mm_srli_epi16(_mm_add_epi16(tHigh, _mm_srli_epi16(tHigh, 8)), 8);
+
+        _mm_storeu_si128((__m128i*) &dst[index], _mm_packus_epi16(tLow, tHigh));
+    }
+
+    glyphBlendScalar(&dst[index], &coverage[index], count - index, level);
+}
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+/**
+ * @brief NEON version of glyphBlendScalar, 8 pixels at a time.
+ */
+static inline void glyphBlendNEON(uint8_t* dst, const uint8_t* coverage, uint32_t count, uint8_t level)
+{
+    const uint8x8_t full = vdup_n_u8(255);
+    const uint8x8_t ink = vdup_n_u8(level);
+
+    uint32_t index = 0;
+
+    for (; index + 8 <= count; index += 8)
+    {
+        uint8x8_t d = vld1_u8(&dst[index]);
+        uint8x8_t c = vld1_u8(&coverage[index]);
+
+        uint16x8_t x = vmull_u8(d, vsub_u8(full, c));
+        x = vmlal_u8(x, ink, c);
+
+        /* (x + 128 + ((x + 128) >> 8)) >> 8 */
+        vst1_u8(&dst[index], vrshrn_n_u16(vrsraq_n_u16(x, x, 8), 8));
+    }
+
+    glyphBlendScalar(&dst[index], &coverage[index], count - index, level);
+}
+#endif
+
+/**
+ * @brief Blend with the fastest kernel available to the compiler.
+ */
+static inline void glyphBlend(uint8_t* dst, const uint8_t* coverage, uint32_t count, uint8_t level)
+{
+#if defined(__SSE2__)
+    glyphBlendSSE2(dst, coverage, count, level);
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    glyphBlendNEON(dst, coverage, count, level);
+#else
+    glyphBlendScalar(dst, coverage, count, level);
+#endif
+}
+
+#endif // __UIF_UI_GLYPHBLEND_H__
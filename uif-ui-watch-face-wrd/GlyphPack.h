@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_GLYPHPACK_H__
+#define __UIF_UI_GLYPHPACK_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-ui-watch-face-wrd/GlyphPackFormat.h"
+
+class GrayFrameBuffer;
+
+/*  Packs emitted by tools/glyphpack. Only available when the build includes
+    the generated sources, see WATCH_FACE_GLYPH_PACK.
+*/
+extern const glyph_pack_t GlyphPack_Hours;
+extern const glyph_pack_t GlyphPack_Minutes;
+extern const glyph_pack_t GlyphPack_Dayndate;
+extern const glyph_pack_t GlyphPack_Seconds;    // 0-9 in the Dayndate font
+extern const glyph_pack_t GlyphPack_Menu;
+
+/*  Metrics emitted by tools/glyphpack -m, see WATCH_FACE_GLYPH_METRICS.
+*/
+extern const glyph_metrics_t GlyphMetrics_Hours[24];      // 00-23
+extern const glyph_metrics_t GlyphMetrics_Minutes[10];    // 0-9
+extern const glyph_metrics_t GlyphMetrics_Dayndate[38];   // SUN-SAT, 01-31
+
+/**
+ * @brief Find the pre-rendered bitmap for a label.
+ *
+ * @param pack Glyph pack to search.
+ * @param label '\0'-terminated string.
+ * @return Entry in the pack's index, NULL if the label is not in the pack.
+ */
+const glyph_pack_entry_t* glyphPackFind(const glyph_pack_t* pack, const char* label);
+
+/**
+ * @brief Draw a pack entry straight from flash into a frame buffer.
+ *
+ * @param pack Glyph pack the entry belongs to.
+ * @param entry Entry to draw.
+ * @param canvas FrameBuffer-object wrapped in a SharedPointer.
+ * @param xOffset Number of pixels the entry is clipped on the left, <= 0.
+ * @param yOffset Number of pixels the entry is clipped at the top, <= 0.
+ * @param inverse Draw white ink on black instead of black ink on white.
+ * @param gray The canvas as a GrayFrameBuffer, for callers that know it is
+ *        one, NULL otherwise.
+ *
+ * Grayscale entries are blended into gray when built with
+ * WATCH_FACE_GRAYSCALE, and thresholded without a gray canvas. Canvases
+ * arrive as FrameBuffer, so the caller picks gray once per canvas.
+ */
+void glyphPackDraw(const glyph_pack_t* pack,
+                   const glyph_pack_entry_t* entry,
+                   SharedPointer<FrameBuffer>& canvas,
+                   int16_t xOffset,
+                   int16_t yOffset,
+                   bool inverse,
+                   GrayFrameBuffer* gray = NULL);
+
+/**
+ * @brief Draw only the ink of a pack entry, at any position in a frame buffer.
+ * @details Unlike glyphPackDraw the background is left alone, so several
+ *          entries can be drawn into one canvas whose background was
+ *          filled once.
+ *
+ * @param pack Glyph pack the entry belongs to.
+ * @param entry Entry to draw.
+ * @param canvas FrameBuffer-object wrapped in a SharedPointer.
+ * @param x Canvas column of the entry's left edge, can be negative.
+ * @param y Canvas row of the entry's top edge, can be negative.
+ * @param inverse Draw white ink instead of black ink.
+ * @param gray The canvas as a GrayFrameBuffer, see glyphPackDraw.
+ */
+void glyphPackDrawInk(const glyph_pack_t* pack,
+                      const glyph_pack_entry_t* entry,
+                      SharedPointer<FrameBuffer>& canvas,
+                      int32_t x,
+                      int32_t y,
+                      bool inverse,
+                      GrayFrameBuffer* gray = NULL);
+
+class GlyphPackView : public UIView
+{
+public:
+    /**
+     * @brief UIView drawing a label from a glyph pack.
+     * @details The bitmap is read directly from the pack. Nothing is copied
+     *          or rendered when the view is created, and the label does not
+     *          have to outlive the view.
+     *
+     * @param pack Glyph pack holding the label.
+     * @param label '\0'-terminated string to look up.
+     */
+    GlyphPackView(const glyph_pack_t* pack, const char* label);
+
+    /**
+     * @brief Fill frame buffer with the label's bitmap.
+     *
+     * @param canvas FrameBuffer-object wrapped in a SharedPointer.
+     * @param xOffset Number of pixels the camera has been translated along the
+     *        horizontal axis.
+     * @param yOffset Number of pixels the camera has been translated along the
+     *        vertical axis.
+     * @return The time in milliseconds to when the object wants to be called
+     *         again. The content is static so this is always 0xFFFFFFFF.
+     */
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
+
+    /**
+     * @brief Draw white ink on black instead of black ink on white.
+     */
+    void setInverse(bool inverse);
+
+    /**
+     * @brief Show another label from the same pack.
+     * @details Only the pointer into the pack changes, nothing is allocated.
+     *
+     * @param label '\0'-terminated string to look up.
+     */
+    void setLabel(const char* label);
+
+    /**
+     * @brief Tell the view whether it is drawn into gray canvases.
+     * @details The flag belongs to the view's owner, which knows what it
+     *          draws into and can switch all its views at once. While it
+     *          is set, canvases are taken to be GrayFrameBuffers or windows
+     *          of one and gray entries are blended into them.
+     *
+     * @param gray Flag read on every draw, NULL (default) to threshold
+     *        gray entries. Must outlive the view.
+     */
+    void setGrayCanvas(const bool* gray);
+
+private:
+    const glyph_pack_t* pack;
+    const glyph_pack_entry_t* entry;
+    bool inverse;
+    const bool* grayCanvas;
+};
+
+#endif // __UIF_UI_GLYPHPACK_H__
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_GLYPHPACKFORMAT_H__
+#define __UIF_UI_GLYPHPACKFORMAT_H__
+
+#include <stdint.h>
+
+/*  A glyph pack is a const table of pre-rendered labels, generated at build
+    time by tools/glyphpack and placed in flash. This header only depends on
+    <stdint.h> so the host tools can share the decoder with the target.
+
+    GLYPH_FORMAT_BITMAP: 1 bit per pixel, rows padded to whole bytes, most
+    significant bit first. A set bit is ink.
+
+    GLYPH_FORMAT_RLE: for every row, run lengths in bytes alternating between
+    background and ink, starting with background. The runs of a row add up to
+    the glyph width. Runs longer than 255 are split with a zero-length run of
+    the other color in between.
+
+    GLYPH_FORMAT_GRAY2, GLYPH_FORMAT_GRAY4: anti-aliased coverage with 2 or 4
+    bits per pixel, rows padded to whole bytes, leftmost pixel in the most
+    significant bits. 0 is background, all bits set is full ink.
+*/
+typedef enum {
+    GLYPH_FORMAT_BITMAP = 0,
+    GLYPH_FORMAT_RLE    = 1,
+    GLYPH_FORMAT_GRAY2  = 2,
+    GLYPH_FORMAT_GRAY4  = 3
+} glyph_format_t;
+
+typedef struct {
+    const char* label;
+    uint32_t offset;    // offset into the pack's data array
+    uint16_t width;
+    uint16_t height;
+    uint8_t format;     // glyph_format_t
+} glyph_pack_entry_t;
+
+/*  Size of a label as rendered, independent of how its bitmap is stored.
+    Emitted by tools/glyphpack -m in the order of the labels file, so tables
+    can be indexed by the value a label shows.
+*/
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+} glyph_metrics_t;
+
+typedef struct {
+    uint16_t entries;
+    const glyph_pack_entry_t* index;
+    const uint8_t* data;
+} glyph_pack_t;
+
+/**
+ * @brief Bits per pixel of a grayscale format, 0 for the 1 bpp formats.
+ */
+static inline uint8_t glyphFormatGrayBits(uint8_t format)
+{
+    return (format == GLYPH_FORMAT_GRAY4) ? 4 : (format == GLYPH_FORMAT_GRAY2) ? 2 : 0;
+}
+
+/**
+ * @brief Coverage of pixel x in a row of a grayscale entry, scaled to 0-255.
+ */
+static inline uint8_t glyphGrayCoverage(const uint8_t* line, uint32_t x, uint8_t bits)
+{
+    uint32_t shift = 8 - bits - ((x * bits) % 8);
+    uint32_t value = (line[(x * bits) / 8] >> shift) & ((1 << bits) - 1);
+
+    return (bits == 4) ? value * 17 : value * 85;
+}
+
+/**
+ * @brief Decode the ink of a pack entry as horizontal runs.
+ * @details Calls sink.ink(x0, x1, y) for every run of ink within the
+ *          visible area, x1 exclusive. Coordinates are in the destination,
+ *          where pixel (x, y) shows bitmap pixel (x - xOffset, y - yOffset).
+ *          Grayscale entries are thresholded at half coverage, so 1 bpp
+ *          canvases can show them.
+ *
+ * @param pack Glyph pack the entry belongs to.
+ * @param entry Entry to decode.
+ * @param xOffset Number of pixels the entry is clipped on the left, <= 0.
+ * @param yOffset Number of pixels the entry is clipped at the top, <= 0.
+ * @param columns Visible width in the destination.
+ * @param rows Visible height in the destination.
+ * @param sink Object receiving the runs.
+ */
+template <typename Sink>
+void glyphPackForEachRun(const glyph_pack_t* pack,
+                         const glyph_pack_entry_t* entry,
+                         int32_t xOffset,
+                         int32_t yOffset,
+                         int32_t columns,
+                         int32_t rows,
+                         Sink& sink)
+{
+    const uint8_t* data = &pack->data[entry->offset];
+
+    if (entry->format == GLYPH_FORMAT_RLE)
+    {
+        /*  Rows clipped at the top still have to be walked through since
+            rows have no fixed size.
+        */
+        for (int32_t line = 0; line < (int32_t) entry->height; line++)
+        {
+            int32_t y = line + yOffset;
+
+            if (y >= rows)
+            {
+                break;
+            }
+
+            int32_t x = 0;
+            bool ink = false;
+
+            while (x < (int32_t) entry->width)
+            {
+                int32_t length = *data++;
+
+                if (ink && (y >= 0) && (length > 0))
+                {
+                    int32_t x0 = x + xOffset;
+                    int32_t x1 = x0 + length;
+
+                    x0 = (x0 < 0) ? 0 : x0;
+                    x1 = (x1 > columns) ? columns : x1;
+
+                    if (x0 < x1)
+                    {
+                        sink.ink(x0, x1, y);
+                    }
+                }
+
+                x += length;
+                ink = !ink;
+            }
+        }
+    }
+    else
+    {
+        uint8_t bits = glyphFormatGrayBits(entry->format);
+        uint32_t stride = (bits) ? ((entry->width * bits) + 7) / 8 : (entry->width + 7) / 8;
+
+        for (int32_t y = 0; y < rows; y++)
+        {
+            const uint8_t* line = &data[(y - yOffset) * stride];
+            int32_t start = -1;
+
+            for (int32_t x = 0; x < columns; )
+            {
+                uint32_t column = x - xOffset;
+
+                /*  Bitmap bytes that are all background or all ink, and
+                    fully visible, end or extend the current run in one step.
+                */
+                if (!bits && ((column % 8) == 0) && (x + 8 <= columns) &&
+                    ((line[column / 8] == 0x00) || (line[column / 8] == 0xFF)))
+                {
+                    if ((line[column / 8] == 0xFF) && (start < 0))
+                    {
+                        start = x;
+                    }
+                    else if ((line[column / 8] == 0x00) && (start >= 0))
+                    {
+                        sink.ink(start, x, y);
+                        start = -1;
+                    }
+
+                    x += 8;
+                    continue;
+                }
+
+                bool set = (bits) ? (glyphGrayCoverage(line, column, bits) >= 128)
+                                  : (line[column / 8] & (0x80 >> (column % 8)));
+
+                if (set && (start < 0))
+                {
+                    start = x;
+                }
+                else if (!set && (start >= 0))
+                {
+                    sink.ink(start, x, y);
+                    start = -1;
+                }
+
+                x++;
+            }
+
+            if (start >= 0)
+            {
+                sink.ink(start, columns, y);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decode a grayscale pack entry as rows of coverage.
+ * @details Calls sink.coverage(x, y, values, count) once per visible row,
+ *          values holding the coverage, 0-255, of pixels x to
+ *          x + count - 1. Coordinates are as for glyphPackForEachRun.
+ *
+ * @param pack Glyph pack the entry belongs to.
+ * @param entry Entry to decode, GLYPH_FORMAT_GRAY2 or GLYPH_FORMAT_GRAY4.
+ * @param xOffset Number of pixels the entry is clipped on the left, <= 0.
+ * @param yOffset Number of pixels the entry is clipped at the top, <= 0.
+ * @param columns Visible width in the destination.
+ * @param rows Visible height in the destination.
+ * @param sink Object receiving the rows.
+ */
+template <typename Sink>
+void glyphPackForEachSpan(const glyph_pack_t* pack,
+                          const glyph_pack_entry_t* entry,
+                          int32_t xOffset,
+                          int32_t yOffset,
+                          int32_t columns,
+                          int32_t rows,
+                          Sink& sink)
+{
+    const uint8_t* data = &pack->data[entry->offset];
+    uint8_t bits = glyphFormatGrayBits(entry->format);
+    uint32_t stride = ((entry->width * bits) + 7) / 8;
+
+    /* rows are handed out in chunks to keep the buffer on the stack small */
+    uint8_t values[64];
+
+    for (int32_t y = 0; y < rows; y++)
+    {
+        const uint8_t* line = &data[(y - yOffset) * stride];
+
+        for (int32_t x = 0; x < columns; x += sizeof(values))
+        {
+            int32_t count = columns - x;
+
+            if (count > (int32_t) sizeof(values))
+            {
+                count = sizeof(values);
+            }
+
+            for (int32_t index = 0; index < count; index++)
+            {
+                values[index] = glyphGrayCoverage(line, x + index - xOffset, bits);
+            }
+
+            sink.coverage(x, y, values, count);
+        }
+    }
+}
+
+#endif // __UIF_UI_GLYPHPACKFORMAT_H__
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_GRAYFRAMEBUFFER_H__
+#define __UIF_UI_GRAYFRAMEBUFFER_H__
+
+#include "uif-ui-watch-face-wrd/ScrollFrameBuffer.h"
+
+/**
+ * @brief Frame buffer for 4 and 16 level grayscale panels.
+ * @details Pixels are packed 2 or 4 bits each, rows padded to whole bytes,
+ *          leftmost pixel in the most significant bits. Drawing through
+ *          the FrameBuffer interface maps color 0 to black and any other
+ *          color to white, so 1 bpp views draw unchanged. Anti-aliased glyphs
+ *          are blended in with blendSpan. Only compiled with
+ *          WATCH_FACE_GRAYSCALE.
+ */
+class GrayFrameBuffer : public ScrollFrameBuffer
+{
+public:
+    /**
+     * @param buffer Pixel memory, at least height rows of
+     *        (width * bitsPerPixel + 7) / 8 bytes. Not owned.
+     * @param bitsPerPixel 2 or 4.
+     * @param width Width in pixels.
+     * @param height Height in pixels.
+     */
+    GrayFrameBuffer(uint8_t* buffer, uint8_t bitsPerPixel, uint16_t width, uint16_t height);
+
+    virtual void drawPixel(uint16_t x, uint16_t y, uint8_t color);
+
+    /**
+     * @return Gray level of the pixel, 0 to 2^bitsPerPixel - 1.
+     */
+    virtual uint8_t getPixel(uint16_t x, uint16_t y) const;
+
+    virtual void drawRectangle(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint8_t color);
+    virtual uint16_t getWidth() const;
+    virtual uint16_t getHeight() const;
+
+    /**
+     * @brief Window into this frame buffer, sharing its pixels.
+     * @details The window is a GrayFrameBuffer too, so views drawn into
+     *          windows of the canvas given to WatchFaceUI::setGrayCanvas or
+     *          MenuTable::setGrayCanvas can blend into them.
+     */
+    virtual SharedPointer<FrameBuffer> getFrameBuffer(int16_t x, int16_t y, uint16_t width, uint16_t height);
+
+    /**
+     * @brief Move a block of pixels up, see ScrollFrameBuffer.
+     * @details Whole bytes of each row are moved with memmove, pixels
+     *          sharing a byte with the columns outside one at a time.
+     */
+    virtual void scrollUp(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint16_t rows);
+
+    /**
+     * @brief Blend coverage into a row of pixels.
+     * @details Pixels are blended in place, one byte of packed pixels at a
+     *          time, with glyphBlendPixel and rounded to the nearest level.
+     *          Bytes without coverage are left alone and fully covered
+     *          bytes are stored whole.
+     *
+     * @param x First pixel.
+     * @param y Row.
+     * @param coverage Coverage of each pixel, 0-255.
+     * @param count Number of pixels, clipped to the frame buffer.
+     * @param level Gray level of the ink, 0 black to 255 white.
+     */
+    void blendSpan(uint16_t x, uint16_t y, const uint8_t* coverage, uint16_t count, uint8_t level);
+
+private:
+    GrayFrameBuffer(uint8_t* buffer, uint8_t bitsPerPixel, uint16_t stride,
+                    uint16_t xOrigin, uint16_t yOrigin, uint16_t width, uint16_t height);
+
+    uint8_t readLevel(uint32_t x, uint32_t y) const;
+    void writeLevel(uint32_t x, uint32_t y, uint8_t level);
+
+    uint8_t* buffer;
+    uint8_t bitsPerPixel;
+    uint16_t stride;
+    uint16_t xOrigin;
+    uint16_t yOrigin;
+    uint16_t width;
+    uint16_t height;
+};
+
+#endif // __UIF_UI_GRAYFRAMEBUFFER_H__
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_MENULABEL_H__
+#define __UIF_UI_MENULABEL_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-ui-watch-face-wrd/GlyphPackFormat.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+
+/* Longest menu label plus '\0'. */
+#define MENU_LABEL_SIZE 12
+
+/* Bytes in the label cache, none with glyph packs, see WATCH_FACE_MENU_LABEL_CACHE. */
+#if WATCH_FACE_GLYPH_PACK
+#define MENU_LABEL_CACHE 0
+#else
+#define MENU_LABEL_CACHE WATCH_FACE_MENU_LABEL_CACHE
+#endif
+
+/**
+ * @brief Create the view for a menu table row in Font_Menu.
+ * @details Reads the bitmap from GlyphPack_Menu when WATCH_FACE_GLYPH_PACK is
+ *          enabled. Otherwise the label is rasterized once into the
+ *          MenuLabelCache and drawn from there, or wrapped in a UITextView
+ *          if it does not fit.
+ *
+ * @param label '\0'-terminated string. Does not have to outlive the view.
+ * @param gray Flag telling glyph pack views they are drawn into gray
+ *        canvases, see GlyphPackView::setGrayCanvas. NULL (default) for none.
+ * @return Newly allocated UIView.
+ */
+UIView* createMenuLabel(const char* label, const bool* gray = NULL);
+
+#if MENU_LABEL_CACHE
+/*  Fonts labels are cached in. The font is part of the key, so labels
+    in other fonts can share the cache.
+*/
+typedef enum {
+    MENU_FONT_MENU
+} menu_font_t;
+
+/**
+ * @brief Process-wide cache of rasterized labels.
+ * @details Labels are rendered once by a UITextView and kept as
+ *          GLYPH_FORMAT_BITMAP entries in MENU_LABEL_CACHE bytes of static
+ *          memory, so the same label shown by several tables, or scrolled
+ *          past several times, is rasterized once. Labels are kept packed;
+ *          when a new one does not fit, the least recently used ones are
+ *          evicted and the rest moved down. Entries are keyed by string and
+ *          font and only stay valid until the next call to insert.
+ */
+class MenuLabelCache
+{
+public:
+    typedef struct {
+        uint32_t hits;          // labels found for new views and visible rows
+        uint32_t misses;        // labels rasterized
+        uint32_t evictions;
+        uint32_t rejected;      // labels too large, or only evictable entries in use
+        uint32_t bytes;         // bitmap bytes in use
+        uint32_t entries;
+    } statistics_t;
+
+    /**
+     * @brief Look up a label, marking it as used.
+     *
+     * @param label '\0'-terminated string.
+     * @param font Font the label is rendered in.
+     * @param hit Count a found label in statistics_t::hits. Lookups that
+     *        only keep a label, such as MenuTable::prefetchRows, pass false.
+     * @return Entry in getPack(), NULL if the label is not cached.
+     */
+    static const glyph_pack_entry_t* find(const char* label, menu_font_t font, bool hit = true);
+
+    /**
+     * @brief Check that an entry returned earlier still holds a label.
+     * @details Does not search the cache or mark the label as used, for
+     *          views redrawing an entry they kept.
+     *
+     * @param entry Entry returned by find or insert.
+     * @param label '\0'-terminated string.
+     * @param font Font the label is rendered in.
+     * @return True if the entry was not evicted or reused since.
+     */
+    static bool contains(const glyph_pack_entry_t* entry, const char* label, menu_font_t font);
+
+    /**
+     * @brief Rasterize a label that is not cached into the cache.
+     *
+     * @param label '\0'-terminated string, shorter than MENU_LABEL_SIZE.
+     * @param font Font to render the label in.
+     * @param keepSince Entries used at or after this getUseCount value are
+     *        not evicted. 0xFFFFFFFF lets any entry be evicted.
+     * @return Entry in getPack(), NULL if the label cannot be cached.
+     */
+    static const glyph_pack_entry_t* insert(const char* label, menu_font_t font,
+                                            uint32_t keepSince = 0xFFFFFFFF);
+
+    /**
+     * @brief Pack holding the bitmaps of the cached entries.
+     */
+    static const glyph_pack_t* getPack(void);
+
+    /**
+     * @brief Number of uses so far, increases with every find and insert.
+     */
+    static uint32_t getUseCount(void);
+
+    static const statistics_t& getStatistics(void);
+
+    /**
+     * @brief Drop every label.
+     */
+    static void clear(void);
+};
+
+/**
+ * @brief UIView drawing a label from the MenuLabelCache.
+ * @details The view keeps its entry and only looks the label up again if
+ *          the entry was evicted, so redraws are not counted as uses. The
+ *          label is copied, so the view can rasterize it again.
+ */
+class MenuLabelView : public UIView
+{
+public:
+    /**
+     * @param label '\0'-terminated string, shorter than MENU_LABEL_SIZE.
+     * @param font Font to render the label in.
+     * @param entry The label's entry in the cache, for its size.
+     */
+    MenuLabelView(const char* label, menu_font_t font, const glyph_pack_entry_t* entry);
+
+    /**
+     * @brief Fill frame buffer with the label's bitmap.
+     *
+     * @param canvas FrameBuffer-object wrapped in a SharedPointer.
+     * @param xOffset Number of pixels the camera has been translated along the
+     *        horizontal axis.
+     * @param yOffset Number of pixels the camera has been translated along the
+     *        vertical axis.
+     * @return The time in milliseconds to when the object wants to be called
+     *         again. The content is static so this is always 0xFFFFFFFF.
+     */
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
+
+private:
+    char label[MENU_LABEL_SIZE];
+    menu_font_t font;
+    const glyph_pack_entry_t* entry;
+};
+#endif
+
+#endif // __UIF_UI_MENULABEL_H__
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_MENUTABLE_H__
+#define __UIF_UI_MENUTABLE_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-ui-watch-face-wrd/MenuLabel.h"
+
+/**
+ * @brief Table of Font_Menu labels, the base of the Set<something>MenuTable
+ *        classes.
+ * @details The first and last rows are blank fillers of getFillerHeight
+ *          pixels, every other row is WATCH_FACE_MENU_ROW_HEIGHT pixels and
+ *          shows the label returned by labelAtIndex, if any. Besides the
+ *          per-row UIView::Array interface used by UITableView, the rows
+ *          visible through a viewport can be drawn in one pass with
+ *          fillVisibleRows.
+ */
+class MenuTable : public UIView::Array
+{
+public:
+    typedef struct {
+        uint32_t frames;            // fillVisibleRows calls
+        uint32_t droppedFrames;     // frames longer than the frame interval
+        uint32_t hits;              // visible labels found in the label cache
+        uint32_t misses;            // visible labels rasterized during the frame
+        uint32_t prefetched;        // rows rendered by prefetchRows
+        uint32_t budgetStops;       // prefetchRows calls cut short by the budget
+    } statistics_t;
+
+    MenuTable(void);
+
+    /**
+     * @brief Get UIView object at the given index.
+     *
+     * @param index Cell to retrieve. Index must be between getFirstIndex
+     *              and getLastIndex.
+     * @return UIView-object wrapped inside a SharedPointer
+     */
+    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const;
+
+    /**
+     * @brief Get pixel height of the cell at the given index.
+     *
+     * @param index Cell to get height of. Index must be between getFirstIndex
+     *              and getLastIndex.
+     * @return Height in number of pixels.
+     */
+    virtual uint32_t heightAtIndex(uint32_t index) const;
+
+    /**
+     * @brief Get pixel width of the cell at the given index.
+     *
+     * @param index Cell to get width of. Index must be between getFirstIndex
+     *              and getLastIndex.
+     * @return Width in number of pixels.
+     */
+    virtual uint32_t widthAtIndex(uint32_t index) const;
+
+    /**
+     * @brief Draw every row visible through a viewport into one canvas.
+     * @details The rows are found from the scroll offset without walking
+     *          the table, and their labels are drawn left aligned and
+     *          vertically centered, as UITableView places the views from
+     *          viewAtIndex. With WATCH_FACE_GLYPH_PACK the labels are drawn
+     *          straight from GlyphPack_Menu into the canvas. Otherwise
+     *          they are drawn from the MenuLabelCache, and labels missing
+     *          from it are rasterized into the cache first, so a label is
+     *          rendered once however many frames it stays in view. Labels
+     *          drawn in the frame are not evicted for others in it.
+     *
+     * @param strip Canvas the size of the viewport.
+     * @param scrollOffset Pixels from the top of the table to the top of
+     *        the viewport.
+     * @param xOffset Number of pixels the labels are clipped on the left,
+     *        <= 0.
+     * @return Number of labels drawn.
+     */
+    uint32_t fillVisibleRows(SharedPointer<FrameBuffer>& strip, uint32_t scrollOffset,
+                             int16_t xOffset = 0);
+
+    /**
+     * @brief Declare that the table is drawn into gray canvases.
+     * @details With WATCH_FACE_GRAYSCALE and glyph packs, the strips given to
+     *          fillVisibleRows and the canvases the views from viewAtIndex
+     *          are drawn into are then taken to be GrayFrameBuffers, or
+     *          windows of one, and anti-aliased labels are blended into
+     *          them. Otherwise labels are thresholded.
+     *
+     * @param gray True when the table is shown on a GrayFrameBuffer,
+     *        false (default) otherwise.
+     */
+    void setGrayCanvas(bool gray);
+
+    /**
+     * @brief Rasterize the rows about to scroll into view into the
+     *        MenuLabelCache.
+     * @details Meant for idle time between frames. Up to a viewport of rows
+     *          is rasterized one at a time, nearest to the viewport first,
+     *          until the cache cannot take more without evicting a label
+     *          drawn in the last frame or prefetched since, or until the
+     *          budget is spent. A row that is started is always finished,
+     *          so a call can overrun the budget by the cost of one row. Does
+     *          nothing without a label cache.
+     *
+     * @param scrollOffset Pixels from the top of the table to the top of
+     *        the viewport.
+     * @param viewportHeight Height of the viewport in pixels.
+     * @param direction Positive when scrolling towards the end of the
+     *        table, negative towards the start.
+     * @param budget Milliseconds the call may spend.
+     * @return Number of rows rendered.
+     */
+    uint32_t prefetchRows(uint32_t scrollOffset, uint32_t viewportHeight,
+                          int32_t direction, uint32_t budget);
+
+    /**
+     * @brief Get label cache and frame statistics for this table.
+     * @details Hits and misses are only counted with a label cache.
+     */
+    const statistics_t& getStatistics(void) const;
+
+protected:
+    /**
+     * @brief Get the label shown in the row at the given index.
+     *
+     * @param index Row, between 0 and getSize() - 1.
+     * @param buffer MENU_LABEL_SIZE bytes for labels that are built on the fly.
+     * @return '\0'-terminated string, NULL for a blank row.
+     */
+    virtual const char* labelAtIndex(uint32_t index, char* buffer) const = 0;
+
+    /**
+     * @brief Get pixel height of the first and last row.
+     * @return WATCH_FACE_PANEL_HEIGHT unless overridden, so the first and
+     *         last label can be scrolled to the middle of the panel.
+     */
+    virtual uint32_t getFillerHeight(void) const;
+
+private:
+    uint32_t rowHeight(uint32_t index, uint32_t size, uint32_t filler) const;
+    uint32_t rowAtOffset(uint32_t offset, uint32_t filler, int32_t* top) const;
+#if !WATCH_FACE_GLYPH_PACK
+    bool drawLabel(const char* label, SharedPointer<FrameBuffer>& strip, int16_t xOffset,
+                   int32_t top, uint32_t height);
+#endif
+
+    statistics_t statistics;
+    bool grayCanvas;
+
+#if MENU_LABEL_CACHE
+    /* getUseCount at the start of the last frame */
+    uint32_t frameStart;
+#endif
+};
+
+#endif // __UIF_UI_MENUTABLE_H__
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_MENUTABLEVIEW_H__
+#define __UIF_UI_MENUTABLEVIEW_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-ui-watch-face-wrd/MenuTable.h"
+
+/**
+ * @brief UIView showing a MenuTable through a scrolling viewport.
+ * @details Every frame draws the rows in view with
+ *          MenuTable::fillVisibleRows. What is left of the frame profile's
+ *          interval afterwards is idle time, which is spent on
+ *          MenuTable::prefetchRows in the direction the table last moved,
+ *          so the rows about to scroll into view are rasterized before
+ *          they are needed. The scroll offset is set by the application,
+ *          from whatever input drives the menu.
+ */
+class MenuTableView : public UIView
+{
+public:
+    /**
+     * @param table Table to show.
+     */
+    MenuTableView(SharedPointer<MenuTable> table);
+
+    /**
+     * @brief Fill frame buffer with the rows in view.
+     *
+     * @param canvas FrameBuffer-object wrapped in a SharedPointer.
+     * @param xOffset Number of pixels the camera has been translated along the
+     *        horizontal axis.
+     * @param yOffset Number of pixels the camera has been translated along the
+     *        vertical axis.
+     * @return The frame profile's interval while the table is moving,
+     *         0xFFFFFFFF once it has stopped.
+     */
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
+
+    /**
+     * @brief Scroll the table.
+     *
+     * @param offset Pixels from the top of the table to the top of the
+     *        viewport.
+     */
+    void setScrollOffset(uint32_t offset);
+
+    uint32_t getScrollOffset(void) const;
+
+    /**
+     * @brief The table shown, for its statistics.
+     */
+    SharedPointer<MenuTable> getTable(void);
+
+private:
+    SharedPointer<MenuTable> table;
+    uint32_t scrollOffset;
+    uint32_t drawnOffset;
+    int32_t direction;
+};
+
+#endif // __UIF_UI_MENUTABLEVIEW_H__
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_SCROLLFRAMEBUFFER_H__
+#define __UIF_UI_SCROLLFRAMEBUFFER_H__
+
+#include "UIFramework/FrameBuffer.h"
+
+/**
+ * @brief Frame buffer that can move pixels in place.
+ * @details Implemented by canvases with direct access to their pixel memory,
+ *          which can move whole rows with memmove instead of redrawing
+ *          them. Used by WatchFaceUI::setRowScroll on the canvas given to
+ *          WatchFaceUI::setScrollCanvas.
+ */
+class ScrollFrameBuffer : public FrameBuffer
+{
+public:
+    /**
+     * @brief Move a block of pixels up.
+     * @details Rows y0 + rows to y1 - 1 of columns x0 to x1 - 1 move up by
+     *          rows. The bottom rows keep their old content.
+     *
+     * @param x0 First column.
+     * @param x1 Column after the last.
+     * @param y0 First row.
+     * @param y1 Row after the last.
+     * @param rows Number of rows to move up by.
+     */
+    virtual void scrollUp(uint16_t x0, uint16_t x1, uint16_t y0, uint16_t y1, uint16_t rows) = 0;
+};
+
+#endif // __UIF_UI_SCROLLFRAMEBUFFER_H__
@@ -18,9 +18,9 @@
 #ifndef __UIF_UI_SETDATEMENUTABLE_H__
 #define __UIF_UI_SETDATEMENUTABLE_H__
 
-#include "UIFramework/UIView.h"
+#include "uif-ui-watch-face-wrd/MenuTable.h"
 
-class SetDateMenuTable : public UIView::Array
+class SetDateMenuTable : public MenuTable
 {
 public:
     /**
@@ -30,33 +30,6 @@ public:
      */
     virtual uint32_t getSize(void) const;
 
-    /**
-     * @brief Get UIView object at the given index.
-     *
-     * @param index Cell to retrieve. Index must be between getFirstIndex
-     *              and getLastIndex.
-     * @return UIView-object wrapped inside a SharedPointer
-     */
-    virtual SharedPointer<UIView> viewAtIndex(uint32_t index) const;
-
-    /**
-     * @brief Get pixel height of the cell at the given index.
-     *
-     * @param index Cell to get height of. Index must be between getFirstIndex
-     *              and getLastIndex.
-     * @return Height in number of pixels.
-     */
-    virtual uint32_t heightAtIndex(uint32_t index) const;
-
-    /**
-     * @brief Get pixel width of the cell at the given index.
-     *
-     * @param index Cell to get width of. Index must be between getFirstIndex
-     *              and getLastIndex.
-     * @return Width in number of pixels.
-     */
-    virtual uint32_t widthAtIndex(uint32_t index) const;
-
     /**
      * @brief Get the table's title.
      * @return const char* to '/0'-terminated string. Can be NULL.
@@ -89,6 +62,9 @@ public:
      *         contains the result of the invoked action.
      */
     virtual SharedPointer<UIView::Action> actionAtIndex(uint32_t index);
+
+protected:
+    virtual const char* labelAtIndex(uint32_t index, char* buffer) const;
 };
 
 #endif // __UIF_UI_SETDATEMENUTABLE_H__
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACEALLOCATION_H__
+#define __UIF_UI_WATCHFACEALLOCATION_H__
+
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* distinct call sites remembered per scope */
+#define WATCH_FACE_ALLOCATION_SITES 8
+
+/**
+ * @brief Counts the allocations made while it is in scope.
+ * @details Scopes nest, and an allocation is counted by every scope open
+ *          at the time. Allocations are only seen through a hook calling
+ *          recordAllocation and recordRelease: the operator new and delete
+ *          built with WATCH_FACE_ALLOCATION_HOOK, or ones a host tool
+ *          defines itself. Not thread safe, like the rest of the UI.
+ *
+ *          For example, to check that a frame does not allocate:
+ *
+ *              WatchFaceAllocationScope scope;
+ *              face.fillFrameBuffer(canvas, 0, 0);
+ *              ...scope.getAllocations() == 0
+ */
+class WatchFaceAllocationScope
+{
+public:
+    typedef struct {
+        const void* site;           // return address in the caller of operator new
+        uint32_t allocations;
+        uint32_t bytes;
+    } site_t;
+
+    WatchFaceAllocationScope(void);
+    ~WatchFaceAllocationScope(void);
+
+    /**
+     * @brief Get number of allocations since the scope was opened.
+     */
+    uint32_t getAllocations(void) const;
+
+    /**
+     * @brief Get number of releases since the scope was opened.
+     */
+    uint32_t getReleases(void) const;
+
+    /**
+     * @brief Get number of bytes requested since the scope was opened.
+     */
+    uint32_t getBytes(void) const;
+
+    /**
+     * @brief Get number of distinct call sites that allocated.
+     * @details Only the first WATCH_FACE_ALLOCATION_SITES sites are kept,
+     *          allocations from later ones are counted but not attributed.
+     */
+    uint32_t getSites(void) const;
+
+    /**
+     * @brief Get call site.
+     *
+     * @param index Site, between 0 and getSites() - 1, in order of the
+     *        first allocation made from it.
+     */
+    const site_t& getSite(uint32_t index) const;
+
+    /**
+     * @brief Count an allocation in every open scope.
+     * @details Called by the allocation hook. Does not allocate.
+     *
+     * @param size Bytes requested.
+     * @param site Address identifying the caller, usually
+     *        __builtin_return_address(0) inside operator new.
+     */
+    static void recordAllocation(size_t size, const void* site);
+
+    /**
+     * @brief Count a release in every open scope.
+     */
+    static void recordRelease(void);
+
+private:
+    /* scopes are neither copied nor assigned */
+    WatchFaceAllocationScope(const WatchFaceAllocationScope&);
+    WatchFaceAllocationScope& operator=(const WatchFaceAllocationScope&);
+
+    WatchFaceAllocationScope* outer;
+
+    uint32_t allocations;
+    uint32_t releases;
+    uint32_t bytes;
+    uint32_t siteCount;
+    site_t sites[WATCH_FACE_ALLOCATION_SITES];
+
+    static WatchFaceAllocationScope* innermost;
+};
+
+#endif // __UIF_UI_WATCHFACEALLOCATION_H__
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACECLOCK_H__
+#define __UIF_UI_WATCHFACECLOCK_H__
+
+#include <stdint.h>
+
+/*  Snapshot of the calendar fields shown on the face.
+*/
+typedef struct {
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t day;
+    uint8_t date;
+} watch_face_time_t;
+
+class WatchFaceClock
+{
+public:
+    virtual ~WatchFaceClock() {}
+
+    /**
+     * @brief Get the current time of day.
+     *
+     * @param hour Hour, 0-23.
+     * @param minute Minute, 0-59.
+     * @param second Second, 0-59.
+     */
+    virtual void getTime(uint8_t* hour, uint8_t* minute, uint8_t* second) = 0;
+
+    /**
+     * @brief Get day in month.
+     * @return Date, 1-31.
+     */
+    virtual uint8_t getDate(void) = 0;
+
+    /**
+     * @brief Get day of the week.
+     * @return Day, 0-6 with 0 being Sunday.
+     */
+    virtual uint8_t getDay(void) = 0;
+
+    /**
+     * @brief Get number of days in the current month.
+     * @return Days, 28-31.
+     */
+    virtual uint8_t getDaysInMonth(void) = 0;
+
+    /**
+     * @brief Get monotonic time used for timing animations.
+     * @return Time in milliseconds.
+     */
+    virtual uint32_t getTimeInMilliseconds(void) = 0;
+};
+
+/**
+ * @brief Clock backed by the platform Calendar and the UIFramework tick.
+ * @details This is the clock used by WatchFaceUI unless another one is given.
+ */
+class WatchFaceCalendarClock : public WatchFaceClock
+{
+public:
+    virtual void getTime(uint8_t* hour, uint8_t* minute, uint8_t* second);
+    virtual uint8_t getDate(void);
+    virtual uint8_t getDay(void);
+    virtual uint8_t getDaysInMonth(void);
+    virtual uint32_t getTimeInMilliseconds(void);
+};
+
+/**
+ * @brief Clock where time only moves when told to.
+ * @details Lets host tools run any number of independent faces, each frozen
+ *          at or stepping through its own point in time.
+ */
+class WatchFaceVirtualClock : public WatchFaceClock
+{
+public:
+    WatchFaceVirtualClock();
+
+    virtual void getTime(uint8_t* hour, uint8_t* minute, uint8_t* second);
+    virtual uint8_t getDate(void);
+    virtual uint8_t getDay(void);
+    virtual uint8_t getDaysInMonth(void);
+    virtual uint32_t getTimeInMilliseconds(void);
+
+    /**
+     * @brief Set time of day and day of week/month.
+     * @details The millisecond counter is left untouched.
+     */
+    void set(uint8_t hour, uint8_t minute, uint8_t second, uint8_t day, uint8_t date);
+
+    /**
+     * @brief Set the millisecond counter.
+     */
+    void setTimeInMilliseconds(uint32_t milliseconds);
+
+    /**
+     * @brief Move the clock forward.
+     * @details Time of day wraps at midnight, advancing day and date. Date
+     *          wraps after 31 since the clock has no notion of month.
+     *
+     * @param milliseconds Time to advance.
+     */
+    void advance(uint32_t milliseconds);
+
+private:
+    uint32_t milliseconds;
+    uint32_t millisecondOfDay;
+    uint8_t day;
+    uint8_t date;
+};
+
+#endif // __UIF_UI_WATCHFACECLOCK_H__
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACECOMPLICATION_H__
+#define __UIF_UI_WATCHFACECOMPLICATION_H__
+
+#include "UIFramework/FrameBuffer.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceClock.h"
+
+/**
+ * @brief Data shown in a region of the watch face next to the time, e.g.,
+ *        battery level, step count or the next alarm.
+ * @details Registered with WatchFaceUI::addComplication, which decides when
+ *          to refresh and draw it.
+ */
+class WatchFaceComplication
+{
+public:
+    virtual ~WatchFaceComplication() {}
+
+    /**
+     * @brief Refresh the data shown.
+     * @details Called once per refresh interval, possibly somewhat early so
+     *          the refresh shares a wakeup with the face.
+     *
+     * @param now Calendar snapshot of the frame.
+     * @return True if the data changed and the region has to be redrawn.
+     */
+    virtual bool update(const watch_face_time_t& now) = 0;
+
+    /**
+     * @brief Draw the data.
+     *
+     * @param canvas The complication's region, cleared to black.
+     * @param xOffset Columns of the region cut off at the left, <= 0.
+     * @param yOffset Rows of the region cut off at the top, <= 0.
+     */
+    virtual void draw(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset) = 0;
+};
+
+#endif // __UIF_UI_WATCHFACECOMPLICATION_H__
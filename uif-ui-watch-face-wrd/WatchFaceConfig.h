@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACECONFIG_H__
+#define __UIF_UI_WATCHFACECONFIG_H__
+
+/*  Build options for the watch face and menu tables. Each option can be
+    overridden from the build system, e.g., -DWATCH_FACE_GLYPH_PACK=1.
+*/
+
+/*  Panel the face and menus are laid out for. Spacing and menu rows are
+    given for the 128x128 reference panel and scaled to the panel at compile
+    time, so the reference build is unchanged. Larger panels need glyph packs
+    rendered for their size, see tools/glyphpack/packs.sh.
+*/
+#ifndef WATCH_FACE_PANEL_WIDTH
+#define WATCH_FACE_PANEL_WIDTH 128
+#endif
+
+#ifndef WATCH_FACE_PANEL_HEIGHT
+#define WATCH_FACE_PANEL_HEIGHT WATCH_FACE_PANEL_WIDTH
+#endif
+
+/* Scale a length on the reference panel to a panel of the given height. */
+#define WATCH_FACE_SCALE_TO(length, panel) ((((length) * (panel)) + 64) / 128)
+#define WATCH_FACE_SCALE(length) WATCH_FACE_SCALE_TO(length, WATCH_FACE_PANEL_HEIGHT)
+
+#ifndef WATCH_FACE_MENU_ROW_HEIGHT
+#define WATCH_FACE_MENU_ROW_HEIGHT WATCH_FACE_SCALE(35)
+#endif
+
+/*  Draw text from the pre-rendered glyph packs in flash instead of converting
+    strings through UITextView at runtime. Requires the GlyphPack_* sources
+    generated by tools/glyphpack to be part of the build.
+*/
+#ifndef WATCH_FACE_GLYPH_PACK
+#define WATCH_FACE_GLYPH_PACK 0
+#endif
+
+/*  Bytes of rasterized menu labels kept for all menu tables, see
+    MenuLabelCache. A label takes a bit per pixel, rows padded to whole
+    bytes, and up to one label per 128 bytes is tracked in a 36 byte entry
+    on 32-bit targets. The default costs 5248 bytes of static RAM, 4096
+    for the bitmaps and 1152 for 32 entries. Not used with
+    WATCH_FACE_GLYPH_PACK, which draws menu labels straight from flash.
+    0 removes the cache, and menu labels are rendered by a UITextView
+    every time they are drawn.
+*/
+#ifndef WATCH_FACE_MENU_LABEL_CACHE
+#define WATCH_FACE_MENU_LABEL_CACHE 4096
+#endif
+
+/*  Anti-aliased text for 4 and 16 level grayscale panels. Glyph pack
+    entries in the GLYPH_FORMAT_GRAY formats are blended into a
+    GrayFrameBuffer when the display provides one as canvas, and are
+    thresholded on any other canvas.
+    Requires WATCH_FACE_GLYPH_PACK. With 0, none of the grayscale code is
+    built and gray entries are drawn thresholded.
+*/
+#ifndef WATCH_FACE_GRAYSCALE
+#define WATCH_FACE_GRAYSCALE 0
+#endif
+
+/*  Lay out the face from the glyph metrics tables generated alongside the
+    glyph packs instead of measuring rendered cells. Requires the
+    GlyphMetrics_* tables emitted by tools/glyphpack -m.
+*/
+#ifndef WATCH_FACE_GLYPH_METRICS
+#define WATCH_FACE_GLYPH_METRICS WATCH_FACE_GLYPH_PACK
+#endif
+
+/*  Define operator new and delete on top of malloc and free, so
+    WatchFaceAllocationScope counts allocations on target. Leave at 0 when
+    the application or a host tool replaces them itself; its operator new
+    and delete then call WatchFaceAllocationScope::recordAllocation and
+    recordRelease.
+*/
+#ifndef WATCH_FACE_ALLOCATION_HOOK
+#define WATCH_FACE_ALLOCATION_HOOK 0
+#endif
+
+/*  Frame pacing profile for animations, see WatchFaceFrameGovernor. It
+    also sets the limits of the minute roll's frame-budget watchdog.
+    SMOOTH favors frame rate, LOW_POWER spends less CPU per animation.
+*/
+#define WATCH_FACE_PROFILE_SMOOTH 0
+#define WATCH_FACE_PROFILE_LOW_POWER 1
+
+#ifndef WATCH_FACE_FRAME_PROFILE
+#define WATCH_FACE_FRAME_PROFILE WATCH_FACE_PROFILE_SMOOTH
+#endif
+
+#endif // __UIF_UI_WATCHFACECONFIG_H__
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACEFIXEDUI_H__
+#define __UIF_UI_WATCHFACEFIXEDUI_H__
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+#include "uif-ui-watch-face-wrd/WatchFaceLayout.h"
+
+/**
+ * @brief Watch face for a panel of fixed size.
+ * @details Same face as WatchFaceUI, but laid out by WatchFaceFixedLayout
+ *          so positions are resolved at compile time from the panel size
+ *          and font set, leaving only the animation margin and camera
+ *          offset to runtime. The cells are drawn in FONTS::fonts, the
+ *          glyph packs or fonts rendered for the panel. The view is
+ *          WIDTH x HEIGHT and should not be resized. Use WatchFaceUI for
+ *          panels only known at runtime.
+ *
+ *          FONTS is the font set of WatchFaceFixedLayout, which also
+ *          provides the cells' fonts:
+ *
+ *          struct Fonts {
+ *              enum { HOURS_HEIGHT = ..., MINUTES_HEIGHT = ..., DAYNDATE_HEIGHT = ... };
+ *              static const watch_face_metrics_t metrics;
+ *              static const watch_face_fonts_t fonts;
+ *          };
+ *
+ *          typedef WatchFaceFixedUI<128, 128, Fonts> WatchFace128;
+ */
+template <uint16_t WIDTH, uint16_t HEIGHT, class FONTS>
+class WatchFaceFixedUI : public WatchFaceUI
+{
+public:
+    WatchFaceFixedUI()
+        :   WatchFaceUI(SharedPointer<WatchFaceClock>(new WatchFaceCalendarClock()),
+                        NULL, NULL, &FONTS::metrics, &FONTS::fonts)
+    {
+        setup();
+    }
+
+    WatchFaceFixedUI(SharedPointer<WatchFaceClock> clock)
+        :   WatchFaceUI(clock, NULL, NULL, &FONTS::metrics, &FONTS::fonts)
+    {
+        setup();
+    }
+
+    WatchFaceFixedUI(SharedPointer<WatchFaceClock> clock, const watch_face_state_t& state)
+        :   WatchFaceUI(clock, &state, NULL, &FONTS::metrics, &FONTS::fonts)
+    {
+        setup();
+    }
+
+    /**
+     * @brief Cold start, see the WatchFaceUI constructor of the same
+     *        signature.
+     */
+    WatchFaceFixedUI(SharedPointer<WatchFaceClock> clock, const watch_face_state_t* state,
+                     const uint8_t* snapshot)
+        :   WatchFaceUI(clock, state, snapshot, &FONTS::metrics, &FONTS::fonts)
+    {
+        setup();
+    }
+
+protected:
+    virtual void calculateLayout(const watch_face_time_t& time, WatchFaceLayout::layout_t* layout)
+    {
+        WatchFaceFixedLayout<WIDTH, HEIGHT, FONTS>::calculate(time, layout);
+    }
+
+private:
+    void setup()
+    {
+        UIView::width = WIDTH;
+        UIView::height = HEIGHT;
+    }
+};
+
+#endif // __UIF_UI_WATCHFACEFIXEDUI_H__
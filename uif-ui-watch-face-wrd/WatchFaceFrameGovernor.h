@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACEFRAMEGOVERNOR_H__
+#define __UIF_UI_WATCHFACEFRAMEGOVERNOR_H__
+
+#include <stdint.h>
+
+class WatchFaceFrameGovernor
+{
+public:
+    typedef struct {
+        uint32_t minimumInterval;   // shortest time between frames, ms
+        uint32_t animationBudget;   // CPU time one animation may use, ms
+    } profile_t;
+
+    typedef struct {
+        uint32_t frames;            // animation frames paced
+        uint32_t overruns;          // frames that started later than asked
+        uint32_t lastInterval;
+        uint32_t shortestInterval;
+        uint32_t longestInterval;
+        uint32_t frameCost;         // running average of render + flush, ms
+    } statistics_t;
+
+    typedef struct {
+        uint32_t frameBudget;       // time one frame may take, ms
+        uint32_t overrunLimit;      // time over frameBudget per animation, ms
+        uint32_t cpuLimit;          // time one animation may take in total, ms
+    } watchdog_t;
+
+    static const profile_t PROFILE_SMOOTH;
+    static const profile_t PROFILE_LOW_POWER;
+
+    /**
+     * @brief Pick frame intervals for animations from measured frame cost.
+     * @details The cost of a frame is the time spent rendering plus the time
+     *          between the requested and the actual start of the next frame,
+     *          which covers flushing to the display. Animation progress is
+     *          based on elapsed time, so a frame that starts late simply
+     *          shows a later point of the animation instead of lagging.
+     *
+     * @param profile Interval and CPU budget limits.
+     */
+    WatchFaceFrameGovernor(const profile_t& profile);
+
+    /**
+     * @brief Call when an animation starts.
+     *
+     * @param duration Length of the animation in milliseconds.
+     */
+    void animationStarted(uint32_t duration);
+
+    /**
+     * @brief Call at the start of every frame.
+     *
+     * @param now Current time in milliseconds.
+     */
+    void frameStarted(uint32_t now);
+
+    /**
+     * @brief Call at the end of an animation frame.
+     *
+     * @param now Current time in milliseconds.
+     * @param remaining Time left of the animation in milliseconds.
+     * @return Milliseconds until the next frame.
+     */
+    uint32_t frameFinished(uint32_t now, uint32_t remaining);
+
+    /**
+     * @brief Call at the end of a frame that does not animate.
+     */
+    void idle(void);
+
+    const statistics_t& getStatistics(void) const;
+
+    /**
+     * @brief Limits for a frame-budget watchdog over the paced animations.
+     * @details Derived from the profile, so one profile sets both the pacing
+     *          and the point where an animation is cut short: a frame may
+     *          take 2/5 of the minimum interval, the time over that may add
+     *          up to two frame budgets, and an animation may take 1.5 times
+     *          its CPU budget, leaving the governor room to pace before the
+     *          watchdog steps in. PROFILE_SMOOTH gives 20, 40 and 150 ms,
+     *          PROFILE_LOW_POWER 33, 66 and 37 ms.
+     */
+    const watchdog_t& getWatchdog(void) const;
+
+private:
+    profile_t profile;
+    statistics_t statistics;
+    watchdog_t watchdog;
+
+    uint32_t budgetInterval;
+    uint32_t frameStart;
+    uint32_t frameDue;
+    bool pacing;
+};
+
+#endif // __UIF_UI_WATCHFACEFRAMEGOVERNOR_H__
@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACELAYOUT_H__
+#define __UIF_UI_WATCHFACELAYOUT_H__
+
+#include "uif-ui-watch-face-wrd/GlyphPackFormat.h"
+#include "uif-ui-watch-face-wrd/WatchFaceClock.h"
+#include "uif-ui-watch-face-wrd/WatchFaceConfig.h"
+
+/* Constants to customize watch layout, on the 128x128 reference panel. */
+#define WATCH_FACE_CENTER_SPACE_128 3   // space between hour/minutes and day/date
+#define WATCH_FACE_LINE_SPACE_128 3     // space between hour/day
+#define WATCH_FACE_MINUTE_KERNING_128 2 // space between x0/0x minutes
+
+/* The same scaled to WATCH_FACE_PANEL_HEIGHT. */
+#define WATCH_FACE_CENTER_SPACE WATCH_FACE_SCALE(WATCH_FACE_CENTER_SPACE_128)
+#define WATCH_FACE_LINE_SPACE WATCH_FACE_SCALE(WATCH_FACE_LINE_SPACE_128)
+#define WATCH_FACE_MINUTE_KERNING WATCH_FACE_SCALE(WATCH_FACE_MINUTE_KERNING_128)
+
+typedef struct {
+    int16_t x;
+    int16_t y;
+    uint16_t width;
+    uint16_t height;
+} watch_face_rect_t;
+
+/*  Rendered size of every label the face can show.
+*/
+typedef struct {
+    const glyph_metrics_t* hours;       // indexed by hour, 0-23
+    const glyph_metrics_t* minutes;     // indexed by digit, 0-9
+    const glyph_metrics_t* dayndate;    // days 0-6 followed by dates 1-31
+} watch_face_metrics_t;
+
+/**
+ * @brief Watch face layout computed from glyph metrics alone.
+ * @details Places the cells the same way WatchFaceUI does, centered in the
+ *          face, without creating or rendering any of them. Layout can
+ *          therefore run before drawing, and the regions a change of time
+ *          touches are known up front.
+ */
+class WatchFaceLayout
+{
+public:
+    enum {
+        CELLS = 5
+    };
+
+    typedef struct {
+        watch_face_time_t time;     // time the layout shows
+        uint16_t width;             // face size the layout was computed for
+        uint16_t height;
+        watch_face_rect_t hour;
+        watch_face_rect_t minute_x0;
+        watch_face_rect_t minute_0x;
+        watch_face_rect_t day;
+        watch_face_rect_t date;
+    } layout_t;
+
+    /**
+     * @brief Lay out the face for the given time.
+     *
+     * @param metrics Rendered label sizes.
+     * @param time Time to show. Seconds are ignored.
+     * @param width Face width in pixels.
+     * @param height Face height in pixels.
+     * @param layout Filled with the cell positions, relative to the face.
+     */
+    static void calculate(const watch_face_metrics_t& metrics,
+                          const watch_face_time_t& time,
+                          uint16_t width,
+                          uint16_t height,
+                          layout_t* layout);
+
+    /**
+     * @brief Regions that differ between two layouts.
+     * @details A cell is damaged when it moves, changes size or shows a new
+     *          label. Its region covers both the old and the new rectangle.
+     *
+     * @param from Layout currently on screen.
+     * @param to Layout about to be drawn.
+     * @param regions Array of at least CELLS rectangles.
+     * @return Number of regions filled in.
+     */
+    static uint8_t damage(const layout_t& from, const layout_t& to, watch_face_rect_t* regions);
+};
+
+/**
+ * @brief Layout specialized for a fixed panel size and font set.
+ * @details The margins and vertical positions only depend on the panel and
+ *          the font heights and are folded into constants. Per time, only
+ *          the label widths are looked up and the left margin derived.
+ *          Spacing is scaled to HEIGHT from the reference panel.
+ *
+ *          FONTS provides the font set:
+ *
+ *          struct Fonts {
+ *              enum { HOURS_HEIGHT = ..., MINUTES_HEIGHT = ..., DAYNDATE_HEIGHT = ... };
+ *              static const watch_face_metrics_t metrics;
+ *          };
+ *
+ *          Every label of a font is expected to be FONTS' height for it, as
+ *          is the case for the face's fonts.
+ */
+template <uint16_t WIDTH, uint16_t HEIGHT, class FONTS>
+class WatchFaceFixedLayout
+{
+public:
+    enum {
+        CENTER_SPACE = WATCH_FACE_SCALE_TO(WATCH_FACE_CENTER_SPACE_128, HEIGHT),
+        LINE_SPACE = WATCH_FACE_SCALE_TO(WATCH_FACE_LINE_SPACE_128, HEIGHT),
+        MINUTE_KERNING = WATCH_FACE_SCALE_TO(WATCH_FACE_MINUTE_KERNING_128, HEIGHT),
+        LEFT_SPACE = (int) WIDTH - CENTER_SPACE,
+        TOP_MARGIN = ((int) HEIGHT - (int) FONTS::MINUTES_HEIGHT) / 2,
+        DAY_Y = TOP_MARGIN + FONTS::HOURS_HEIGHT + LINE_SPACE
+    };
+
+    /**
+     * @brief Lay out the face for the given time, see
+     *        WatchFaceLayout::calculate.
+     */
+    static void calculate(const watch_face_time_t& time, WatchFaceLayout::layout_t* layout)
+    {
+        uint16_t hour = FONTS::metrics.hours[time.hour].width;
+        uint16_t minute_x0 = FONTS::metrics.minutes[time.minute / 10].width;
+        uint16_t minute_0x = FONTS::metrics.minutes[time.minute % 10].width;
+        uint16_t day = FONTS::metrics.dayndate[time.day].width;
+        uint16_t date = FONTS::metrics.dayndate[7 + time.date - 1].width;
+
+        int16_t left_margin = (LEFT_SPACE - hour - minute_x0 - minute_0x) / 2;
+
+        layout->time = time;
+        layout->width = WIDTH;
+        layout->height = HEIGHT;
+
+        set(&layout->hour, left_margin, TOP_MARGIN, hour, FONTS::HOURS_HEIGHT);
+
+        set(&layout->minute_x0,
+            left_margin + hour + CENTER_SPACE,
+            TOP_MARGIN, minute_x0, FONTS::MINUTES_HEIGHT);
+
+        set(&layout->minute_0x,
+            layout->minute_x0.x + minute_x0 + MINUTE_KERNING,
+            TOP_MARGIN, minute_0x, FONTS::MINUTES_HEIGHT);
+
+        set(&layout->day, left_margin, DAY_Y, day, FONTS::DAYNDATE_HEIGHT);
+
+        set(&layout->date,
+            left_margin + day + CENTER_SPACE,
+            DAY_Y, date, FONTS::DAYNDATE_HEIGHT);
+    }
+
+private:
+    static void set(watch_face_rect_t* rect, int16_t x, int16_t y, uint16_t width, uint16_t height)
+    {
+        rect->x = x;
+        rect->y = y;
+        rect->width = width;
+        rect->height = height;
+    }
+};
+
+#endif // __UIF_UI_WATCHFACELAYOUT_H__
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACEREGISTRY_H__
+#define __UIF_UI_WATCHFACEREGISTRY_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceUI.h"
+
+/* Faces that can be registered. */
+#define MAX_WATCH_FACES 4
+
+/**
+ * @brief UIView switching between several watch faces.
+ * @details Only the selected face is alive. Inactive faces are kept as a
+ *          watch_face_state_t each, so the memory they hold is bounded by
+ *          MAX_WATCH_FACES * sizeof(watch_face_state_t) regardless of the
+ *          cells they use. A face is resumed with the modes in its state
+ *          and built for the current time when it is selected.
+ */
+class WatchFaceRegistry : public UIView
+{
+public:
+    /**
+     * @brief Create a face, resuming it if a state is given.
+     * @details Also sets up what the state does not cover, such as
+     *          complications.
+     *
+     * @param clock Clock shared by all faces in the registry.
+     * @param state State saved when the face was last deselected, NULL the
+     *        first time the face is selected.
+     * @return Face allocated with new, owned by the registry, NULL if it
+     *         cannot be created.
+     */
+    typedef WatchFaceUI* (*factory_t)(SharedPointer<WatchFaceClock> clock,
+                                      const watch_face_state_t* state);
+
+    typedef struct {
+        uint32_t switches;          // faces selected
+        uint32_t lastSwitchTime;    // ms to save, delete, resume and build, last switch
+        uint32_t worstSwitchTime;   // slowest switch
+        uint32_t inactiveBytes;     // held by the states of inactive faces
+        uint32_t inactiveLimit;     // bound on inactiveBytes
+    } statistics_t;
+
+    /**
+     * @param clock Clock passed to every face.
+     */
+    WatchFaceRegistry(SharedPointer<WatchFaceClock> clock);
+
+    virtual ~WatchFaceRegistry();
+
+    /**
+     * @brief Register a face.
+     * @details The face is created when it is first selected.
+     *
+     * @return Index of the face, -1 if all MAX_WATCH_FACES slots are taken.
+     */
+    int8_t add(factory_t factory);
+
+    /**
+     * @brief Make a face the one shown.
+     * @details The face shown so far saves its state and is deleted, the
+     *          selected face is created from its saved state if it has one
+     *          and its cells are built with WatchFaceUI::prepare, so its
+     *          first frame only draws. lastSwitchTime covers all of it. If
+     *          the factory returns NULL, the previous face is resumed again.
+     *
+     * @param index Index returned by add.
+     * @return False if there is no such face or it could not be created.
+     */
+    bool select(uint8_t index);
+
+    /**
+     * @brief Index of the face shown, -1 before the first frame.
+     */
+    int8_t getSelected(void) const;
+
+    /**
+     * @brief The face shown, NULL before the first frame.
+     */
+    WatchFaceUI* getFace(void);
+
+    /**
+     * @brief Fill frame buffer with the selected face.
+     * @details Selects the first face if none is selected yet. The face is
+     *          given the size of the registry.
+     */
+    virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
+
+    /**
+     * @brief Get switch times and the memory held by inactive faces.
+     */
+    const statistics_t& getStatistics(void) const;
+
+private:
+    WatchFaceUI* create(uint8_t index);
+
+    typedef struct {
+        factory_t factory;
+        watch_face_state_t state;
+        bool saved;
+    } entry_t;
+
+    SharedPointer<WatchFaceClock> clock;
+    statistics_t statistics;
+
+    entry_t entries[MAX_WATCH_FACES];
+    uint8_t count;
+
+    WatchFaceUI* face;
+    int8_t selected;
+};
+
+#endif // __UIF_UI_WATCHFACEREGISTRY_H__
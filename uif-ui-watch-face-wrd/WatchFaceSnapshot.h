@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACESNAPSHOT_H__
+#define __UIF_UI_WATCHFACESNAPSHOT_H__
+
+#include "UIFramework/FrameBuffer.h"
+
+#include <stdint.h>
+
+/**
+ * @brief 1 bit per pixel copy of a canvas, for showing the last face at
+ *        boot before any cell exists.
+ * @details A 4 byte header holds the width and height, little-endian.
+ *          Rows follow top to bottom, most significant bit first and padded
+ *          to whole bytes, so a 128x128 panel takes 2052 bytes. The header
+ *          keeps a snapshot from being drawn on a canvas of another size.
+ */
+class WatchFaceSnapshot
+{
+public:
+    /**
+     * @brief Bytes needed for a snapshot of the given size.
+     */
+    static uint32_t getSize(uint16_t width, uint16_t height);
+
+    /**
+     * @brief Copy the canvas into a snapshot.
+     * @details Any non-zero pixel is stored as set.
+     *
+     * @param canvas Canvas holding the frame to keep.
+     * @param snapshot Buffer of at least getSize bytes.
+     */
+    static void capture(SharedPointer<FrameBuffer>& canvas, uint8_t* snapshot);
+
+    /**
+     * @brief Draw a snapshot onto a canvas of the size it was taken from.
+     * @details Set pixels are drawn as horizontal runs on a cleared canvas.
+     *
+     * @return False, with nothing drawn, if the canvas has another size.
+     */
+    static bool blit(const uint8_t* snapshot, SharedPointer<FrameBuffer>& canvas);
+};
+
+#endif // __UIF_UI_WATCHFACESNAPSHOT_H__
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2016, ARM Limited, All Rights Reserved
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UIF_UI_WATCHFACETRACE_H__
+#define __UIF_UI_WATCHFACETRACE_H__
+
+#include "UIFramework/UIView.h"
+
+#include "uif-ui-watch-face-wrd/WatchFaceClock.h"
+
+#include <cstdio>
+
+/*  Modes of the face during a frame, see watch_face_frame_t::modes.
+*/
+#define WATCH_FACE_FRAME_AMBIENT 0x01           // setAmbient(true)
+#define WATCH_FACE_FRAME_SECONDS 0x02           // setSeconds(true)
+#define WATCH_FACE_FRAME_ROW_SCROLL 0x04        // setRowScroll(true)
+#define WATCH_FACE_FRAME_RETAINED_CANVAS 0x08   // setRetainedCanvas(true)
+#define WATCH_FACE_FRAME_HIDDEN 0x10            // setVisible(false), nothing drawn
+#define WATCH_FACE_FRAME_BOOT 0x20              // cold start snapshot shown
+
+/*  One call to WatchFaceUI::fillFrameBuffer.
+*/
+typedef struct {
+    uint32_t timestamp;     // clock milliseconds when the call started
+    watch_face_time_t time; // calendar snapshot used for the frame, or
+                            // the time on screen for hidden and boot frames
+    uint8_t modes;          // WATCH_FACE_FRAME_* set during the frame
+    int16_t xOffset;
+    int16_t yOffset;
+    uint32_t delay;         // value returned by fillFrameBuffer
+    uint32_t renderTime;    // milliseconds spent in fillFrameBuffer
+    uint32_t hash;          // WatchFaceTrace::hash of the canvas afterwards
+} watch_face_frame_t;
+
+class WatchFaceTraceRecorder
+{
+public:
+    virtual ~WatchFaceTraceRecorder() {}
+
+    /**
+     * @brief Called by WatchFaceUI after every frame.
+     */
+    virtual void record(const watch_face_frame_t& frame) = 0;
+};
+
+class WatchFaceTrace
+{
+public:
+    /**
+     * @brief FNV-1a hash of every pixel in the canvas.
+     */
+    static uint32_t hash(SharedPointer<FrameBuffer>& canvas);
+};
+
+/**
+ * @brief Recorder writing frames to a compact binary trace file.
+ * @details The file is a 4 byte "WFT1" header followed by one 26 byte
+ *          little-endian record per frame.
+ */
+class WatchFaceTraceFile : public WatchFaceTraceRecorder
+{
+public:
+    /**
+     * @param file File opened for binary writing. Not closed by the recorder.
+     */
+    WatchFaceTraceFile(FILE* file);
+
+    virtual void record(const watch_face_frame_t& frame);
+
+    /**
+     * @brief Read and check the header of a trace file.
+     * @return False if the file is not a trace.
+     */
+    static bool readHeader(FILE* file);
+
+    /**
+     * @brief Read the next frame from a trace file, after readHeader.
+     * @return False at end of file.
+     */
+    static bool read(FILE* file, watch_face_frame_t* frame);
+
+private:
+    FILE* file;
+};
+
+#endif // __UIF_UI_WATCHFACETRACE_H__
@@ -21,9 +21,79 @@
 #include "UIFramework/UIView.h"
 #include "UIFramework/UITextView.h"
 
+#include "uif-ui-watch-face-wrd/WatchFaceClock.h"
+#include "uif-ui-watch-face-wrd/WatchFaceFrameGovernor.h"
+#include "uif-ui-watch-face-wrd/WatchFaceLayout.h"
+#include "uif-ui-watch-face-wrd/ScrollFrameBuffer.h"
+#include "uif-ui-watch-face-wrd/WatchFaceComplication.h"
+
+class WatchFaceTraceRecorder;
+class GrayFrameBuffer;
+
+/* Cells replaced by an animation and the roll over, freed when idle. */
+#define MAX_RETIRED_CELLS 5
+
+/* Complications that can be registered with a face. */
+#define MAX_COMPLICATIONS 4
+
+/*  Compact state of a face, enough to resume it without reading the clock
+    or laying it out again. Written by WatchFaceUI::saveState.
+*/
+typedef struct {
+    watch_face_time_t time;             // time on screen
+    uint8_t flags;                      // modes set on the face
+    uint8_t easing;
+    uint8_t ambientStartHour;
+    uint8_t ambientEndHour;
+    uint8_t ambientInterval;
+    uint16_t width;
+    uint16_t height;
+    uint16_t transitionTime;            // minute roll, ms
+    WatchFaceLayout::layout_t layout;   // layout on screen, with metrics
+} watch_face_state_t;
+
+/*  Fonts the face's cells are drawn in: glyph packs with
+    WATCH_FACE_GLYPH_PACK, UITextView fonts otherwise.
+*/
+typedef struct {
+#if WATCH_FACE_GLYPH_PACK
+    const glyph_pack_t* hours;
+    const glyph_pack_t* minutes;
+    const glyph_pack_t* dayndate;
+    const glyph_pack_t* seconds;
+#else
+    const FontData* hours;
+    const FontData* minutes;
+    const FontData* dayndate;
+    const FontData* seconds;
+#endif
+} watch_face_fonts_t;
+
 class WatchFaceUI : public UIView
 {
 public:
+    typedef enum {
+        EASING_LINEAR,
+        EASING_EASE_OUT,
+        EASING_SPRING
+    } easing_t;
+
+    typedef struct {
+        uint32_t frames;            // calls to fillFrameBuffer
+        uint32_t animations;        // minute rolls started
+        uint32_t animationsSnapped; // rolls cut short by the watchdog
+        uint32_t worstFrameTime;    // slowest fillFrameBuffer, ms
+        uint32_t animationsSkipped; // rolls swapped instantly in ambient mode
+        uint32_t ambientWakeups;    // idle frames in ambient mode
+        uint32_t wakeupsSaved;      // per-minute wakeups slept through
+        uint32_t hiddenFrames;      // calls skipped while hidden
+        uint32_t scrollFrames;      // roll frames drawn by row scroll
+        uint32_t complicationUpdates; // complication refreshes
+        uint32_t complicationDraws; // complication regions drawn
+        uint32_t partialFrames;     // frames drawing only complications or seconds
+        uint32_t secondsDraws;      // seconds readouts drawn
+    } statistics_t;
+
     /**
      * @brief UIFramework implementation of the Wearable Reference Design
      *        watch face.
@@ -32,6 +102,50 @@ public:
      */
     WatchFaceUI();
 
+    /**
+     * @brief Watch face driven by the given clock instead of the Calendar.
+     * @details Each face only reads time through its own clock, which allows
+     *          several faces, each with a virtual clock, to render different
+     *          points in time side by side.
+     *
+     * @param clock WatchFaceClock-object wrapped in a SharedPointer.
+     */
+    WatchFaceUI(SharedPointer<WatchFaceClock> clock);
+
+    /**
+     * @brief Watch face resumed from a state saved by saveState.
+     * @details Neither the clock nor the glyph metrics are read here, and
+     *          no cell is created. The first frame creates the cells for
+     *          the current time and draws it without animating, so resuming
+     *          costs about as much as the regular constructor, only moved
+     *          to the first frame. Complications and the trace
+     *          recorder are not part of the state and have to be set again.
+     *
+     * @param clock WatchFaceClock-object wrapped in a SharedPointer.
+     * @param state State saved from a face of the same kind.
+     */
+    WatchFaceUI(SharedPointer<WatchFaceClock> clock, const watch_face_state_t& state);
+
+    /**
+     * @brief Watch face for a cold start.
+     * @details The state is applied as by the constructor above. The
+     *          first fillFrameBuffer only blits the
+     *          snapshot, so the last face shown reaches the display before
+     *          any cell exists. The next call creates the cells and draws
+     *          the current time. A snapshot taken at another panel size is
+     *          skipped and the first call builds the face.
+     *
+     * @param clock WatchFaceClock-object wrapped in a SharedPointer.
+     * @param state State saved along with the snapshot, not NULL. Only read
+     *        by the constructor.
+     * @param snapshot WatchFaceSnapshot of the canvas, NULL to start with
+     *        building the face. Must stay valid until the first frame.
+     */
+    WatchFaceUI(SharedPointer<WatchFaceClock> clock, const watch_face_state_t* state,
+                const uint8_t* snapshot);
+
+    virtual ~WatchFaceUI();
+
     /**
      * @brief Fill frame buffer with the current time and WRD watch face.
      *
@@ -47,7 +161,352 @@ public:
      */
     virtual uint32_t fillFrameBuffer(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset);
 
+    /**
+     * @brief Record every call to fillFrameBuffer.
+     * @details Attach the recorder right after construction for the trace to
+     *          be replayable, since replay starts from a freshly constructed
+     *          face. Each frame reads the clock's milliseconds twice, at the
+     *          start and at the end, which the trace records as timestamp
+     *          and timestamp + renderTime. tools/tracereplay feeds both back.
+     *          Hidden frames and the snapshot shown at a cold start are
+     *          recorded too, reading the clock once for the timestamp. Every
+     *          frame carries the modes set on the face, which the replay
+     *          sets on its own before the frame.
+     *
+     * @param recorder Object receiving one watch_face_frame_t per frame.
+     *        NULL stops recording. Not owned by the face.
+     */
+    void setTraceRecorder(WatchFaceTraceRecorder* recorder);
+
+    /**
+     * @brief Set the curve used for the minute roll and the re-centering.
+     *
+     * @param easing Easing curve. Default is EASING_EASE_OUT.
+     */
+    void setAnimationEasing(easing_t easing);
+
+    /**
+     * @brief Set the duration of the minute roll.
+     * @details A roll in progress jumps to its end. Longer rolls draw more
+     *          frames; the frame rate is set by the frame profile, see
+     *          WATCH_FACE_FRAME_PROFILE.
+     * @param milliseconds Duration of the roll. Default is 250.
+     */
+    void setTransitionTime(uint16_t milliseconds);
+
+    /**
+     * @brief Enter or leave ambient mode.
+     * @details In ambient mode minute changes swap instantly instead of
+     *          animating and the face only wakes up on multiples of the
+     *          ambient interval, see setAmbientSchedule. With glyph packs
+     *          enabled cells are updated in place without allocating.
+     *          Without them each minute digit that changes is a new
+     *          UITextView, allocated and pre-fetched in the update frame,
+     *          while digits that stay keep their cells.
+     *
+     * @param ambient True to stay in ambient mode regardless of schedule.
+     */
+    void setAmbient(bool ambient);
+
+    /**
+     * @brief Enter ambient mode automatically during part of the day.
+     *
+     * @param startHour First hour of ambient mode, 0-23.
+     * @param endHour Hour ambient mode ends, 0-23. The period may wrap around
+     *        midnight. Equal to startHour disables the schedule.
+     * @param intervalMinutes Minutes between updates in ambient mode, whether
+     *        scheduled or set with setAmbient. Should divide 60.
+     */
+    void setAmbientSchedule(uint8_t startHour, uint8_t endHour, uint8_t intervalMinutes);
+
+    /**
+     * @brief Tell the face whether it is on screen.
+     * @details Call with false when, e.g., a menu covers the face. While
+     *          hidden, fillFrameBuffer returns right away without reading the
+     *          clock, allocating cells or animating. When shown again the
+     *          next frame renders the current time directly, without
+     *          replaying the animations that were missed.
+     *
+     * @param visible False while the face is fully covered.
+     */
+    void setVisible(bool visible);
+
+    /**
+     * @brief Animate the minute roll by scrolling the rows on screen.
+     * @details Instead of redrawing the face, each frame of the roll moves
+     *          the column of the changing digits up by the frame's delta
+     *          and draws only the newly exposed rows of the incoming digits,
+     *          so the cost follows the scroll distance rather than the digit
+     *          size. Frames where this does not apply (camera offset, a
+     *          sliding margin, an easing overshoot, other cells in the
+     *          column) are redrawn as usual.
+     *
+     *          Rows are only scrolled on the canvas set with
+     *          setScrollCanvas, other canvases are redrawn every frame.
+     *
+     * @param enable True to scroll rows, false to redraw (default).
+     */
+    void setRowScroll(bool enable);
+
+    /**
+     * @brief Set the canvas rows can be scrolled on.
+     * @details Canvases are handed to fillFrameBuffer as FrameBuffer, so the
+     *          application names the one that can move its pixels, usually
+     *          the display's. Only frames drawn into this very canvas are
+     *          scrolled, found by comparing pointers.
+     *
+     * @param canvas ScrollFrameBuffer that keeps its content between
+     *        frames, NULL for none (default). Not owned by the face.
+     */
+    void setScrollCanvas(ScrollFrameBuffer* canvas);
+
+    /**
+     * @brief Set the canvas gray glyphs are blended into.
+     * @details With WATCH_FACE_GRAYSCALE, frames drawn into this very canvas
+     *          blend the anti-aliased entries of the face's glyph packs,
+     *          found by comparing pointers once per frame. Other canvases
+     *          get them thresholded.
+     *
+     * @param canvas The display's GrayFrameBuffer, NULL for none (default).
+     *        Not owned by the face.
+     */
+    void setGrayCanvas(GrayFrameBuffer* canvas);
+
+    /**
+     * @brief Save what is needed to resume the face later.
+     * @details Together with the constructor taking a state this lets an
+     *          inactive face be kept in sizeof(watch_face_state_t) bytes
+     *          instead of as live cells, see WatchFaceRegistry.
+     *
+     * @param state Filled with the time on screen, layout and modes.
+     */
+    void saveState(watch_face_state_t* state) const;
+
+    /**
+     * @brief Create the cells of a resumed face now.
+     * @details A face created from a state leaves its cells to the first
+     *          frame. Calling this creates them for the current time
+     *          instead, so the first frame draws without building anything.
+     *          A cold start snapshot not shown yet is dropped. Does nothing
+     *          if the cells exist.
+     */
+    void prepare(void);
+
+    /**
+     * @brief Show seconds below the minutes.
+     * @details The face wakes up every second, except in ambient mode where
+     *          the seconds are hidden. Digits are drawn from ten cells
+     *          created here, so a tick allocates nothing. With a retained
+     *          canvas, see setRetainedCanvas, a tick only redraws the
+     *          seconds and getSecondsDamage reports the rows it touched.
+     *          Without one every tick redraws the whole face.
+     *
+     * @param enable True to show seconds, false to hide them (default).
+     */
+    void setSeconds(bool enable);
+
+    /**
+     * @brief Get the region of the seconds if the last frame drew them.
+     *
+     * @param region Filled with the seconds readout in canvas coordinates.
+     * @return False if the seconds were not drawn by the last frame.
+     */
+    bool getSecondsDamage(watch_face_rect_t* region) const;
+
+    /**
+     * @brief Show a complication in a region of the face.
+     * @details The complication is refreshed every interval and redrawn
+     *          when its data changes. Refreshes are moved up by up to a
+     *          quarter of the interval to share a wakeup the face makes
+     *          anyway, so a complication refreshing less often than the face
+     *          wakes up costs no extra wakeups.
+     *
+     * @param complication Data source and renderer. Not owned by the face.
+     * @param region Area in face coordinates, clear of the time and date.
+     * @param intervalMilliseconds Time between refreshes.
+     * @return False if all MAX_COMPLICATIONS slots are taken.
+     */
+    bool addComplication(WatchFaceComplication* complication,
+                         const watch_face_rect_t& region,
+                         uint32_t intervalMilliseconds);
+
+    /**
+     * @brief Stop showing a complication added with addComplication.
+     */
+    void removeComplication(WatchFaceComplication* complication);
+
+    /**
+     * @brief Tell the face whether the canvas keeps its content between
+     *        frames.
+     * @details With a retained canvas, a frame where only complications
+     *          changed draws just their regions instead of the whole face.
+     *
+     * @param retained True if the same pixels are passed to every
+     *        fillFrameBuffer call, false to draw every frame in full
+     *        (default).
+     */
+    void setRetainedCanvas(bool retained);
+
+    /**
+     * @brief Get the complication regions drawn by the last frame.
+     * @details After a partial frame these are the only regions that
+     *          changed and need to be sent to the display.
+     *
+     * @param regions Array of at least MAX_COMPLICATIONS rectangles.
+     * @return Number of regions filled in.
+     */
+    uint8_t getComplicationDamage(watch_face_rect_t* regions) const;
+
+    /**
+     * @brief Get counters for the work done by the face so far.
+     */
+    const statistics_t& getStatistics(void) const;
+
+    /**
+     * @brief Get the animation frame intervals chosen so far and the
+     *        measured frame cost they were based on.
+     */
+    const WatchFaceFrameGovernor::statistics_t& getFrameStatistics(void) const;
+
+    /**
+     * @brief Get the regions of the face that differ between what is on
+     *        screen and the time being rolled in.
+     * @details Computed from the glyph metrics before anything is drawn, see
+     *          WATCH_FACE_GLYPH_METRICS. Without metrics the whole face is
+     *          reported. No regions while idle.
+     *
+     * @param regions Array of at least WatchFaceLayout::CELLS rectangles.
+     * @return Number of regions filled in.
+     */
+    uint8_t getDamage(watch_face_rect_t* regions) const;
+
+protected:
+    /**
+     * @brief Watch face drawn in other fonts than the panel's defaults, for
+     *        faces of another size such as WatchFaceFixedUI.
+     * @details Starts from the clock, or resumes or cold starts from a
+     *          state as the constructors above.
+     *
+     * @param clock WatchFaceClock-object wrapped in a SharedPointer.
+     * @param state State to resume from, NULL to start from the clock.
+     * @param snapshot WatchFaceSnapshot for a cold start, NULL for none.
+     *        Ignored without a state.
+     * @param metrics Glyph metrics to lay out the face from, NULL to
+     *        measure the cells.
+     * @param fonts Fonts the cells are created in. Not copied.
+     */
+    WatchFaceUI(SharedPointer<WatchFaceClock> clock, const watch_face_state_t* state,
+                const uint8_t* snapshot, const watch_face_metrics_t* metrics,
+                const watch_face_fonts_t* fonts);
+
+    /**
+     * @brief Lay out the face for the given time from the glyph metrics.
+     * @details Only called when metrics are set. Faces of a fixed size
+     *          override this with a layout specialized at compile time.
+     *
+     * @param time Time to lay out.
+     * @param layout Filled with the cell positions.
+     */
+    virtual void calculateLayout(const watch_face_time_t& time, WatchFaceLayout::layout_t* layout);
+
+    /* Glyph metrics to lay out the face from, NULL to measure the cells. */
+    const watch_face_metrics_t* metrics;
+
+    /* Fonts the cells are drawn in. */
+    const watch_face_fonts_t* fonts;
+
 private:
+    /**
+     * @brief Update cells and draw the face for the given point in time.
+     *
+     * @param milliseconds Clock time at the start of the frame.
+     */
+    void renderFrame(SharedPointer<FrameBuffer>& canvas,
+                     int16_t xOffset,
+                     int16_t yOffset,
+                     const watch_face_time_t& now,
+                     uint32_t milliseconds);
+
+    /**
+     * @brief Delay until the next frame while no animation is running.
+     */
+    uint32_t idleDelay(const watch_face_time_t& now, bool ambient);
+
+    /**
+     * @brief Refresh the complications that are due.
+     *
+     * @param milliseconds Clock time of the frame.
+     * @param now Calendar snapshot of the frame.
+     */
+    void updateComplications(uint32_t milliseconds, const watch_face_time_t& now);
+
+    /**
+     * @brief Shorten a delay to wake up for the next complication refresh.
+     */
+    uint32_t complicationDelay(uint32_t milliseconds, uint32_t delay) const;
+
+    /**
+     * @brief Draw complications into their regions.
+     *
+     * @param changed True to only draw the ones with new data.
+     */
+    void drawComplications(SharedPointer<FrameBuffer>& canvas,
+                           int16_t xOffset, int16_t yOffset, bool changed);
+
+    /**
+     * @brief Draw the seconds into seconds_rect.
+     */
+    void drawSeconds(SharedPointer<FrameBuffer>& canvas, uint8_t second);
+
+    /**
+     * @brief Check whether the canvas still holds the last frame drawn.
+     */
+    bool isCanvasRetained(int16_t xOffset, int16_t yOffset) const;
+
+    /**
+     * @brief Pass one frame to the recorder, with the face's modes and the
+     *        hash of the canvas.
+     *
+     * @param start Clock milliseconds when the frame started.
+     * @param now Time drawn by the frame.
+     * @param modes WATCH_FACE_FRAME_BOOT or 0, the other modes are read from
+     *        the face.
+     */
+    void recordFrame(SharedPointer<FrameBuffer>& canvas,
+                     int16_t xOffset, int16_t yOffset,
+                     uint32_t start, const watch_face_time_t& now,
+                     uint32_t delay, uint32_t renderTime, uint8_t modes);
+
+    /**
+     * @brief Record a hidden or boot frame, which draws nothing from the
+     *        clock, with the time on screen and no render time.
+     */
+    void recordShownFrame(SharedPointer<FrameBuffer>& canvas,
+                          int16_t xOffset, int16_t yOffset,
+                          uint32_t delay, uint8_t modes);
+
+    /**
+     * @brief Set every member to its default, and read initial time from
+     *        the clock and allocate cells, or take the modes from a saved
+     *        state and leave the cells to the first frames.
+     *
+     * @param state State to resume from, NULL to start from the clock.
+     * @param snapshot Snapshot to show on the first frame of a resumed
+     *        face, NULL for none. Ignored without a state.
+     */
+    void init(const watch_face_state_t* state, const uint8_t* snapshot);
+
+    /**
+     * @brief Create the cells left to the first frame for the current time.
+     */
+    void buildCells(void);
+
+    /**
+     * @brief Allocate the cells for hour_int, minute_int, day_int and
+     *        date_int.
+     */
+    void createCells(void);
+
     typedef struct {
         int32_t top_margin;
         int32_t left_margin;
@@ -83,15 +542,104 @@ private:
         int32_t date_y_offset;
     } positions_t;
 
+    /**
+     * @brief Map elapsed animation time onto the easing curve.
+     *
+     * @param progress Milliseconds since the animation started.
+     * @return Eased progress as a Q15 fraction. 1 << 15 once the transition
+     *         time has passed. May exceed it during the animation for curves
+     *         that overshoot.
+     */
+    uint32_t easeProgress(uint32_t progress);
+
     /**
      * @brief Calculate new center position with animation taken into account.
      *
      * @param positions posision_t struct to be filled by function.
-     * @param progress Animation progress as a fraction of the total period,
-     *        i.e., 0 <= progress <= period.
-     * @param period Animation period.
+     * @param fraction Eased animation progress from easeProgress. 1 << 15 or
+     *        more means the animation has completed.
      */
-    void calculateCenter(positions_t* positions, uint32_t progress, uint32_t period);
+    void calculateCenter(positions_t* positions, uint32_t fraction);
+
+    /**
+     * @brief Draw a frame of the minute roll by scrolling the digit column.
+     *
+     * @return False if the frame has to be redrawn instead.
+     */
+    bool scrollFrame(SharedPointer<FrameBuffer>& canvas, int16_t xOffset, int16_t yOffset,
+                     uint32_t milliseconds);
+
+    /**
+     * @brief Fill the rows of a cell that fall within a band of the canvas.
+     */
+    static void drawCellRows(SharedPointer<FrameBuffer>& canvas, UIView* cell,
+                             int32_t x, int32_t y, int32_t top, int32_t bottom);
+
+    /**
+     * @brief Delay until the next frame of the running animation.
+     *
+     * @param milliseconds Clock time at the end of the frame.
+     */
+    uint32_t animationDelay(uint32_t milliseconds);
+
+    /**
+     * @brief Whether the running animation has crossed the watchdog limits.
+     */
+    bool watchdogExpired(void) const;
+
+    /**
+     * @brief Lay out the time in hour_int, minute_int, day_int and date_int,
+     *        keeping the layout on screen until the minute roll completes.
+     */
+    void updateLayout(void);
+
+    /**
+     * @brief Bring hour and minute cells to the given time without
+     *        animating.
+     */
+    void syncCells(const watch_face_time_t& now);
+
+    /**
+     * @brief Queue a replaced cell to be freed on the next idle frame.
+     */
+    void retireCell(UIView* cell);
+
+    /**
+     * @brief Free cells queued by retireCell.
+     */
+    void releaseRetiredCells(void);
+
+    /**
+     * @brief Take a pre-staged cell if it was staged for the given value.
+     *
+     * @param staged Staged cell, set to NULL by the call.
+     * @param staged_int Value the cell was staged for.
+     * @param value Value needed now.
+     * @return The staged cell or NULL if none or the value differs.
+     */
+    UIView* takeStagedCell(UIView** staged, uint8_t staged_int, uint8_t value);
+
+    /**
+     * @brief Check whether the hour (and at midnight the day and date) roll
+     *        over still lacks pre-staged cells.
+     */
+    bool needsPrestage(void) const;
+
+    /**
+     * @brief Create the cells for the coming hour, day and date.
+     */
+    void prestageCells(void);
+
+    /**
+     * @brief Check whether ambient mode applies at the given hour.
+     */
+    bool isAmbient(uint8_t hour) const;
+
+    /**
+     * @brief End the minute animation by replacing the current cells with
+     *        the next_ cells.
+     */
+    void completeMinuteAnimation(void);
 
     /**
      * @brief Calculate positions based on the camera view.
@@ -104,17 +652,42 @@ private:
      */
     void calculatePositions(positions_t* positions, int xOffset, int yOffset);
 
+    /**
+     * @brief Calculate positions from the layouts, applying only the margin
+     *        and the camera offset at runtime.
+     *
+     * @param positions positions_t struct with the margins filled in.
+     * @param xBase Camera offset along the horizontal axis, <= 0.
+     * @param yBase Camera offset along the vertical axis, <= 0.
+     */
+    void calculatePositionsFromLayout(positions_t* positions, int xBase, int yBase);
+
+    SharedPointer<WatchFaceClock> clock;
+    WatchFaceTraceRecorder* recorder;
+    statistics_t statistics;
+
+    /* Frame-budget watchdog for the running animation. */
+    uint32_t animationCpuTime;
+    uint32_t animationOverrun;
+
     uint32_t transitionTimeInMilliSeconds;
+    uint32_t progressScale;
+    easing_t easing;
+    WatchFaceFrameGovernor governor;
 
     /* Cache cells between calls. */
-    UITextView* hour_cell;
-    UITextView* next_hour_cell;
-    UITextView* minute_x0_cell;
-    UITextView* minute_0x_cell;
-    UITextView* next_minute_x0_cell;
-    UITextView* next_minute_0x_cell;
-    UITextView* day_cell;
-    UITextView* date_cell;
+    UIView* hour_cell;
+    UIView* next_hour_cell;
+    UIView* minute_x0_cell;
+    UIView* minute_0x_cell;
+    UIView* next_minute_x0_cell;
+    UIView* next_minute_0x_cell;
+    UIView* day_cell;
+    UIView* date_cell;
+
+    /* Layout on screen and the one being rolled in. */
+    WatchFaceLayout::layout_t layout;
+    WatchFaceLayout::layout_t next_layout;
 
     /* Keep track of changes in time. Triggers animations. */
     uint8_t hour_int;
@@ -123,9 +696,78 @@ private:
     uint8_t date_int;
     uint8_t day_int;
 
+    /* Ambient mode. */
+    bool ambientForced;
+    uint8_t ambientStartHour;
+    uint8_t ambientEndHour;
+    uint8_t ambientInterval;
+
+    /* Visibility. Stale when the cells may lag behind the clock. */
+    bool visible;
+    bool stale;
+
+    /* Cells created ahead of the hour and midnight roll over. */
+    UIView* staged_hour_cell;
+    UIView* staged_day_cell;
+    UIView* staged_date_cell;
+    uint8_t staged_hour_int;
+    uint8_t staged_day_int;
+    uint8_t staged_date_int;
+
+    /* Cells waiting to be freed. */
+    UIView* retired[MAX_RETIRED_CELLS];
+    uint8_t retired_cells;
+
     /* Controls animations. */
     bool animateMinute;
     uint32_t animateStartTime;
+
+    /* Row scroll. Offset and margin drawn last, offset -1 if unknown. */
+    bool rowScroll;
+    ScrollFrameBuffer* scrollCanvas;
+
+    /* Gray canvas, and whether the frame being drawn goes into it. Read by
+       the glyph pack cells, see GlyphPackView::setGrayCanvas.
+    */
+    GrayFrameBuffer* grayCanvas;
+    bool grayFrame;
+
+    int32_t scrollOffset;
+    int32_t scrollLeft;
+
+    /* Complications. Bit n of complicationsDrawn is set if slot n was drawn
+       by the last frame.
+    */
+    typedef struct {
+        WatchFaceComplication* complication;
+        watch_face_rect_t region;
+        uint32_t interval;
+        uint32_t deadline;
+        bool changed;
+    } complication_slot_t;
+
+    complication_slot_t complications[MAX_COMPLICATIONS];
+    uint8_t complicationCount;
+    uint8_t complicationsDrawn;
+
+    /* Retained canvas. Size of the face drawn last, unless canvasDrawn is false. */
+    bool retainedCanvas;
+    bool canvasDrawn;
+    uint16_t drawnWidth;
+    uint16_t drawnHeight;
+
+    /* Resume and cold start. Set until the face is built on the first frames. */
+    bool cellsPending;
+    bool pendingSeconds;
+    const uint8_t* bootSnapshot;
+
+    /* Seconds. One cell per digit, second_drawn -1 if not on the canvas. */
+    bool seconds;
+    UIView* second_cells[10];
+    uint16_t second_width;
+    watch_face_rect_t seconds_rect;
+    int8_t second_drawn;
+    bool seconds_damaged;
 };
 
 #endif // __UIF_UI_WATCHFACEUI_H__